@@ -4,12 +4,18 @@
  * Description: 
  * 	Handling files, opening a file and reading any text inside of it, 
  * 	counting statistics about the text. 
+ *
+ * 	The words are split with the tokenizer of the editor, so it is compiled
+ * 	together with it: `g++ -std=c++23 files.cpp ../editor/tokenizer.cpp`.
  * */
 
 #include <iostream>
 #include <fstream>  
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "../editor/tokenizer.hpp"
 
 void print_stats(std::string path);
 
@@ -27,15 +33,18 @@ void print_stats(std::string path){
 
 	if(file.is_open()){
 		// a word is considered any combination of non-whitespace characters
-		std::string word{}; 
-		std::string shortest_word{};
+		std::ostringstream content{};
+		content << file.rdbuf();
+		const std::string text{std::move(content).str()};
+
+		std::string_view shortest_word{};
 		int shortest_word_length{100000};
-		std::string longest_word{};
+		std::string_view longest_word{};
 		int longest_word_length{0};
 		int num_words{0};
 		int total_length{0};  // sum of all words lengths
 		
-		while(file >> word){
+		for(const std::string_view word : editor::split_words(text)){
 			// count words
 			num_words++;
 
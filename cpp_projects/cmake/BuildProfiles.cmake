@@ -0,0 +1,45 @@
+# Build profiles shared by the projects, for single and multi-config generators:
+#   Debug (the default): checked standard library and sanitizers, for tests.
+#   Release: -O3 with link-time optimization, and profile-guided optimization of the targets
+#            given to `enable_pgo`, selected with the PGO cache variable:
+#              PGO=GENERATE builds instrumented targets that write profiles to PGO_DIR when run,
+#              PGO=USE optimizes them with the profiles written before.
+
+get_property(MULTI_CONFIG GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
+if(MULTI_CONFIG)
+    set(CMAKE_CONFIGURATION_TYPES Debug Release CACHE STRING "Build configurations" FORCE)
+elseif(NOT CMAKE_BUILD_TYPE)
+    set(CMAKE_BUILD_TYPE Debug CACHE STRING "Build type: Debug or Release" FORCE)
+endif()
+
+# GCC 12 reports false overlaps in inlined std::string concatenation at -O3
+add_compile_options("$<$<CONFIG:Release>:-Wno-restrict>"
+                    "$<$<NOT:$<CONFIG:Release>>:-D_GLIBCXX_DEBUG;-fsanitize=undefined;-fsanitize=address>"
+)
+add_link_options("$<$<NOT:$<CONFIG:Release>>:-fsanitize=undefined;-fsanitize=address>")
+
+include(CheckIPOSupported)
+check_ipo_supported(RESULT IPO_SUPPORTED LANGUAGES CXX)
+if(IPO_SUPPORTED)
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION_RELEASE ON)
+endif()
+
+set(PGO "" CACHE STRING "Profile-guided optimization of release builds: GENERATE, USE or empty")
+set(PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory of the optimization profiles")
+
+# Add the flags of the PGO step to the release build of a target
+function(enable_pgo target)
+    if(PGO STREQUAL "GENERATE")
+        # counters are updated atomically, since the programs use threads
+        target_compile_options(${target} PRIVATE
+                               "$<$<CONFIG:Release>:-fprofile-generate=${PGO_DIR};-fprofile-update=atomic>")
+        target_link_options(${target} PRIVATE "$<$<CONFIG:Release>:-fprofile-generate=${PGO_DIR}>")
+    elseif(PGO STREQUAL "USE")
+        # functions that the training did not run are optimized as without profiles
+        target_compile_options(${target} PRIVATE
+                               "$<$<CONFIG:Release>:-fprofile-use=${PGO_DIR};-fprofile-partial-training;-Wno-missing-profile;-Wno-error=coverage-mismatch>")
+        target_link_options(${target} PRIVATE "$<$<CONFIG:Release>:-fprofile-use=${PGO_DIR}>")
+    elseif(NOT PGO STREQUAL "")
+        message(FATAL_ERROR "PGO must be GENERATE, USE or empty, got `${PGO}`")
+    endif()
+endfunction()
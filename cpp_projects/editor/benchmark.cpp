@@ -0,0 +1,250 @@
+/**
+ * benchmark.cpp
+ * -------------
+ * Description:
+ *
+ *     ----- Editor Benchmark -----
+ *  This file implements a benchmark of the editor operations on a generated text.
+ *
+ *  The text has words whose frequencies follow a Zipf distribution, like natural
+ *  text: the word of rank r occurs in proportion to 1 / r^s. Frequent words are
+ *  short, and lines have about a dozen words. The text is written to a file, and
+ *  every operation is timed on its own, in the order the program runs them:
+ *  loading the file, splitting it into words, counting, sorting the table by
+ *  keys and by values, removing and substituting a word, and printing the text.
+ *
+ *  For every operation, the time, the throughput over the bytes it works on, and
+ *  the peak resident memory of the process so far are printed. Numbers are only
+ *  meaningful for a release build, configured with `-DCMAKE_BUILD_TYPE=Release`.
+ *
+ *  When running from the command line, any of these arguments can be given:
+ *   --words=<n>: number of words of the text, by default 10000000.
+ *   --vocabulary=<n>: number of distinct words, by default 100000.
+ *   --exponent=<s>: exponent of the Zipf distribution, by default 1.0.
+ *   --seed=<n>: seed of the random generator, by default 1.
+ *   --corpus=<file>: write the text to `file` and keep it, instead of a temporary file.
+ *
+ * Example command:
+ *   `$ ./EditorBenchmark --words=50000000 --exponent=1.1`
+ *
+ **/
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include "editor.hpp"
+#include "output_buffer.hpp"
+#include "tokenizer.hpp"
+
+/**
+ * @brief Stop the program for an invalid argument.
+ *
+ * @param arg: the argument.
+ */
+[[noreturn]] void invalid_argument(const std::string& arg){
+    std::cerr << "ERROR: Argument `" << arg << "` is invalid. Program exited." << std::endl;
+    std::cerr << "Usage: EditorBenchmark [--words=<n>] [--vocabulary=<n>] [--exponent=<s>] [--seed=<n>] "
+                 "[--corpus=<file>]" << std::endl;
+    std::terminate();
+}
+
+/**
+ * @brief Create the word of a rank, the letters of the rank in bijective base 26.
+ *
+ * @param rank: rank of the word, starting at 1.
+ * @return the word, where words of smaller ranks are never longer.
+ */
+std::string word_of_rank(std::size_t rank){
+    std::string word{};
+    while(rank > 0){
+        rank--;
+        word.push_back(static_cast<char>('a' + rank % 26));
+        rank /= 26;
+    }
+    return word;
+}
+
+/**
+ * @brief Write a text of words with Zipf-distributed frequencies.
+ *
+ * @param path: path of the file to write.
+ * @param num_words: number of words of the text.
+ * @param vocabulary: number of distinct words.
+ * @param exponent: exponent of the distribution.
+ * @param seed: seed of the random generator.
+ * @return the number of bytes written.
+ */
+std::size_t write_corpus(const std::string& path, const std::size_t num_words, const std::size_t vocabulary,
+                         const double exponent, const unsigned seed){
+    std::vector<std::string> words(vocabulary);
+    std::vector<double> cumulative(vocabulary);
+    double total{0};
+    for(std::size_t rank{1}; rank <= vocabulary; rank++){
+        words[rank - 1] = word_of_rank(rank);
+        total += 1 / std::pow(static_cast<double>(rank), exponent);
+        cumulative[rank - 1] = total;
+    }
+
+    std::mt19937_64 random{seed};
+    std::uniform_real_distribution<double> uniform{0, total};
+
+    std::ofstream file{path, std::ios::binary};
+    if(!file.is_open()){
+        std::cerr << "ERROR: File `" << path << "` cannot be written." << std::endl;
+        std::terminate();
+    }
+
+    std::size_t size{0};
+    {
+        editor::OutputBuffer output{file};
+        for(std::size_t i{0}; i < num_words; i++){
+            const auto rank{std::ranges::lower_bound(cumulative, uniform(random)) - cumulative.begin()};
+            const std::string& word{words[static_cast<std::size_t>(std::min<std::ptrdiff_t>(rank, vocabulary - 1))]};
+            output.write(word);
+            output.write(i % 12 == 11 ? '\n' : ' ');
+            size += word.size() + 1;
+        }
+    }
+    return size;
+}
+
+// peak resident memory of the process so far, in MB.
+double peak_memory(){
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024;
+}
+
+/**
+ * @brief Run an operation once, and print its time, throughput and the peak memory.
+ *
+ * @param name: name of the operation.
+ * @param bytes: number of bytes the operation works on.
+ * @param operation: the operation, returning its result.
+ * @return the result of the operation.
+ */
+template<typename Operation>
+auto measure(const std::string& name, const std::size_t bytes, Operation operation){
+    const auto start{std::chrono::steady_clock::now()};
+    auto result{operation()};
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << elapsed.count() * 1000
+              << std::setw(12) << static_cast<double>(bytes) / (1 << 20) / elapsed.count()
+              << std::setw(16) << peak_memory() << "\n";
+    return result;
+}
+
+int main(int argc, char** argv){
+    std::size_t num_words{10000000};
+    std::size_t vocabulary{100000};
+    double exponent{1.0};
+    unsigned seed{1};
+    std::string corpus_path{};
+
+    const std::vector<std::string> arguments{argv + 1, argv + argc};
+    for(const std::string& arg : arguments){
+        const std::vector<std::string> arg_parts{editor::parse_argument(arg)};
+        const std::string& flag{arg_parts.at(0)};
+        const std::string& value{arg_parts.at(1)};
+
+        try {
+            std::size_t parsed{0};
+            if (flag == "--words") {
+                num_words = std::stoull(value, &parsed);
+            } else if (flag == "--vocabulary") {
+                vocabulary = std::stoull(value, &parsed);
+            } else if (flag == "--exponent") {
+                exponent = std::stod(value, &parsed);
+            } else if (flag == "--seed") {
+                seed = static_cast<unsigned>(std::stoul(value, &parsed));
+            } else if (flag == "--corpus") {
+                corpus_path = value;
+                parsed = value.size();
+            }
+            if (value.empty() || parsed != value.size() || vocabulary == 0) {
+                invalid_argument(arg);
+            }
+        }
+        catch (const std::logic_error&) {
+            invalid_argument(arg);
+        }
+    }
+
+    const bool keep_corpus{!corpus_path.empty()};
+    if (!keep_corpus) {
+        corpus_path = (std::filesystem::temp_directory_path() / "editor_benchmark.txt").string();
+    }
+
+    const auto generate_start{std::chrono::steady_clock::now()};
+    const std::size_t size{write_corpus(corpus_path, num_words, vocabulary, exponent, seed)};
+    const std::chrono::duration<double> generate_time{std::chrono::steady_clock::now() - generate_start};
+
+    std::cout << "Corpus: " << num_words << " words of " << vocabulary << " distinct ones, "
+              << std::fixed << std::setprecision(1) << static_cast<double>(size) / (1 << 20) << " MB, "
+              << "Zipf exponent " << std::setprecision(2) << exponent << ", generated in "
+              << std::setprecision(1) << generate_time.count() << " s\n\n";
+    std::cout << std::left << std::setw(28) << "Operation" << std::right << std::setw(12) << "Time [ms]"
+              << std::setw(12) << "MB/s" << std::setw(16) << "Peak RSS [MB]" << "\n";
+
+    const std::string text{measure("load", size, [&corpus_path]() {
+        std::ifstream file{corpus_path, std::ios::binary};
+        std::ostringstream content{};
+        content << file.rdbuf();
+        return std::move(content).str();
+    })};
+
+    const std::vector<std::string_view> words{measure("tokenize", size, [&text]() {
+        return editor::split_words(text);
+    })};
+
+    const std::vector<std::string> strings{measure("copy words into strings", size, [&words]() {
+        return std::vector<std::string>(words.begin(), words.end());
+    })};
+
+    const editor::FrequencyTable table{measure("create_frequency_table", size, [&words]() {
+        return editor::create_frequency_table(words);
+    })};
+
+    std::size_t table_bytes{0};
+    for(const auto& [word, count] : table){
+        table_bytes += word.size() + sizeof(count);
+    }
+    measure("sort_table_by_keys", table_bytes, [&table]() {
+        return editor::sort_table_by_keys(table);
+    });
+    measure("sort_table_by_values", table_bytes, [&table]() {
+        return editor::sort_table_by_values(table);
+    });
+
+    // the most frequent words are the ones that edits change the most of the text for.
+    const std::string frequent{word_of_rank(1)};
+    const std::string other{word_of_rank(2)};
+    measure("remove_word", size, [&strings, &frequent]() {
+        return editor::remove_word(strings, frequent);
+    });
+    measure("substitute_word", size, [&strings, &frequent, &other]() {
+        return editor::substitute_word(strings, frequent, other);
+    });
+
+    std::ofstream discard{"/dev/null"};
+    measure("print_text", size, [&strings, &discard]() {
+        editor::print_text(strings, discard);
+        return discard.good();
+    });
+
+    if (!keep_corpus) {
+        std::filesystem::remove(corpus_path);
+    }
+
+    return 0;
+}
+
+// ============== END OF FILE ==============
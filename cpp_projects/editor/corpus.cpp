@@ -0,0 +1,301 @@
+/**
+ * corpus.cpp
+ * ----------
+ * Description:
+ *
+ *     ----- Corpus -----
+ *
+ *  A set of text files, given either as a directory, whose files are all taken
+ *  recursively, or as a pattern of file names in a directory, such as `*.txt`,
+ *  where `*` matches any characters and `?` a single one.
+ *
+ *  The files are processed on a fixed number of threads, each of which takes the
+ *  next file that nobody has started on, so that large and small files are spread
+ *  evenly. While a file is processed, the operating system is asked to read ahead
+ *  a file that will be taken soon, so that reading from disk overlaps with work.
+ *
+ *  For counting, every thread adds the words of its files to its own frequency
+ *  table, and the tables are merged at the end. For printing, every file is edited
+ *  and written to a file of the same name under the output directory, one chunk at
+ *  a time.
+ *
+ **/
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include "corpus.hpp"
+#include "mapped_file.hpp"
+#include "tokenizer.hpp"
+#include "word_stream.hpp"
+
+namespace editor {
+    namespace helper {
+        // ask the operating system to start reading a file into its cache.
+        void read_ahead(const std::filesystem::path& path){
+            const int fd{open(path.c_str(), O_RDONLY)};
+            if(fd >= 0){
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                close(fd);
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether a file name matches a pattern.
+     *
+     * @param pattern: the pattern, where `*` matches any characters and `?` a single one.
+     * @param name: the file name.
+     * @return whether the whole name matches.
+     */
+    bool match_pattern(const std::string_view pattern, const std::string_view name){
+        std::size_t p{0};
+        std::size_t n{0};
+        // position after the last star, and the name position it was tried at.
+        std::size_t star{std::string_view::npos};
+        std::size_t retry{0};
+
+        while(n < name.size()){
+            if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])){
+                p++;
+                n++;
+            }
+            else if(p < pattern.size() && pattern[p] == '*'){
+                star = ++p;
+                retry = n;
+            }
+            else if(star != std::string_view::npos){
+                p = star;
+                n = ++retry;
+            }
+            else{
+                return false;
+            }
+        }
+
+        while(p < pattern.size() && pattern[p] == '*'){
+            p++;
+        }
+        return p == pattern.size();
+    }
+
+    /**
+     * @brief Find the files of a corpus.
+     *
+     * @param path: a directory, a pattern of file names in a directory, or a single file.
+     * @throws std::runtime_error if no file is found.
+     */
+    Corpus::Corpus(const std::string& path)
+        : _root{}, _files{}
+    {
+        const std::filesystem::path given{path};
+        std::error_code error{};
+
+        if(std::filesystem::is_directory(given, error)){
+            _root = given;
+            for(const auto& entry : std::filesystem::recursive_directory_iterator{given, error}){
+                if(entry.is_regular_file()){
+                    _files.push_back(entry.path().lexically_relative(given));
+                }
+            }
+        }
+        else if(const std::string name{given.filename().string()}; name.find_first_of("*?") != std::string::npos){
+            _root = given.has_parent_path() ? given.parent_path() : std::filesystem::path{"."};
+            for(const auto& entry : std::filesystem::directory_iterator{_root, error}){
+                if(entry.is_regular_file() && match_pattern(name, entry.path().filename().string())){
+                    _files.push_back(entry.path().filename());
+                }
+            }
+        }
+        else if(std::filesystem::is_regular_file(given, error)){
+            _root = given.has_parent_path() ? given.parent_path() : std::filesystem::path{"."};
+            _files.push_back(given.filename());
+        }
+
+        if(_files.empty()){
+            throw std::runtime_error("No files found at `" + path + "`.");
+        }
+        std::ranges::sort(_files);
+    }
+
+    // the directory that all files are relative to.
+    const std::filesystem::path& Corpus::root() const{
+        return _root;
+    }
+
+    // the files, relative to the root, in sorted order.
+    const std::vector<std::filesystem::path>& Corpus::files() const{
+        return _files;
+    }
+
+    /**
+     * @brief Create a frequency table of the words of all files.
+     *
+     * @param num_threads: number of threads to use, zero chooses it from the number of cores.
+     * @return a table of words and their frequencies.
+     * @throws std::runtime_error if a file cannot be read.
+     */
+    FrequencyTable Corpus::frequency_table(const unsigned num_threads) const{
+        std::vector<FrequencyTable> tables(_thread_count(num_threads));
+
+        _for_each_file([this, &tables](const std::size_t thread, const std::filesystem::path& file){
+            const MappedFile text{(_root / file).string()};
+            FrequencyTable& table{tables[thread]};
+            std::ranges::for_each(split_words(text.view()), [&table](const std::string_view word){
+                table.add(word);
+            });
+        }, tables.size());
+
+        for(std::size_t t{1}; t < tables.size(); t++){
+            tables[0].merge(std::move(tables[t]));
+        }
+        return std::move(tables[0]);
+    }
+
+    /**
+     * @brief Count the n-grams of the edited words of all files.
+     *
+     * Every thread counts the files it takes into its own table, and the tables are
+     * merged at the end. No n-gram spans two files.
+     *
+     * @param n: number of words of every n-gram.
+     * @param edits: the edits applied to the words before they are counted.
+     * @param max_entries: number of n-grams above which every table drops rare ones, zero for no limit.
+     * @param num_threads: number of threads to use, zero chooses it from the number of cores.
+     * @param normalizer: normalizes the words before they are edited, if given, copied for every thread.
+     * @return the table of n-grams.
+     * @throws std::runtime_error if a file cannot be read.
+     */
+    NgramTable Corpus::ngrams(const std::size_t n, const WordEdits& edits, const std::size_t max_entries,
+                              const unsigned num_threads, const Normalizer* const normalizer) const{
+        std::vector<NgramTable> tables{};
+        std::vector<std::optional<Normalizer>> normalizers(_thread_count(num_threads));
+        for(std::optional<Normalizer>& copy : normalizers){
+            tables.emplace_back(n, max_entries);
+            if(normalizer){
+                copy = *normalizer;
+            }
+        }
+
+        _for_each_file([this, &edits, &tables, &normalizers](const std::size_t thread,
+                                                            const std::filesystem::path& file){
+            std::ifstream is{_root / file, std::ios::binary};
+            if(!is.is_open()){
+                throw std::runtime_error("File `" + (_root / file).string() + "` not found.");
+            }
+            tables[thread].add(is, edits, normalizers[thread] ? &*normalizers[thread] : nullptr);
+        }, tables.size());
+
+        for(std::size_t t{1}; t < tables.size(); t++){
+            tables[0].merge(tables[t]);
+        }
+        return std::move(tables[0]);
+    }
+
+    /**
+     * @brief Print the edited words of every file to a file of the same name under a directory.
+     *
+     * The output is the same as `print_text` of each edited file. The output directory
+     * must not be the root of the corpus.
+     *
+     * @param edits: the edits applied to the words.
+     * @param output: the output directory, created if it does not exist.
+     * @param num_threads: number of threads to use, zero chooses it from the number of cores.
+     * @param normalizer: normalizes the words before they are edited, if given, copied for every thread.
+     * @throws std::runtime_error if a file cannot be read or written.
+     */
+    void Corpus::write(const WordEdits& edits, const std::filesystem::path& output, const unsigned num_threads,
+                       const Normalizer* const normalizer) const{
+        std::error_code error{};
+        if(std::filesystem::equivalent(_root, output, error)){
+            throw std::runtime_error("Directory `" + output.string() + "` would overwrite the corpus.");
+        }
+
+        std::vector<std::optional<Normalizer>> normalizers(_thread_count(num_threads));
+        if(normalizer){
+            std::ranges::fill(normalizers, *normalizer);
+        }
+
+        _for_each_file([this, &edits, &output, &normalizers](const std::size_t thread,
+                                                            const std::filesystem::path& file){
+            const std::filesystem::path target{output / file};
+            std::filesystem::create_directories(target.parent_path());
+
+            std::ifstream is{_root / file, std::ios::binary};
+            if(!is.is_open()){
+                throw std::runtime_error("File `" + (_root / file).string() + "` not found.");
+            }
+            std::ofstream os{target, std::ios::binary};
+            if(!os.is_open()){
+                throw std::runtime_error("File `" + target.string() + "` cannot be written.");
+            }
+            stream_text(is, edits, os, normalizers[thread] ? &*normalizers[thread] : nullptr);
+        }, normalizers.size());
+    }
+
+    // ------------------- PRIVATE FUNCTIONS -------------------
+
+    // number of threads to process the files with, where zero chooses it from the number of cores.
+    std::size_t Corpus::_thread_count(const unsigned num_threads) const{
+        const std::size_t wanted{num_threads == 0 ? std::thread::hardware_concurrency() : num_threads};
+        return std::clamp<std::size_t>(wanted, 1, _files.size());
+    }
+
+    /**
+     * @brief Process all files on a number of threads, each taking the next file when it is done.
+     *
+     * The first error of any thread stops all threads from taking more files, and is
+     * thrown once all threads are done.
+     *
+     * @param work: called with the index of the thread and a file relative to the root.
+     * @param num_threads: number of threads.
+     */
+    template<typename Work>
+    void Corpus::_for_each_file(Work work, const std::size_t num_threads) const{
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr failure{};
+        std::mutex failure_mutex{};
+
+        const auto run{[&](const std::size_t thread){
+            for(std::size_t i{next++}; i < _files.size(); i = next++){
+                // the file that a thread will take about when this one is done.
+                if(i + num_threads < _files.size()){
+                    helper::read_ahead(_root / _files[i + num_threads]);
+                }
+
+                try{
+                    work(thread, _files[i]);
+                }
+                catch(...){
+                    const std::scoped_lock lock{failure_mutex};
+                    if(!failure){
+                        failure = std::current_exception();
+                    }
+                    next = _files.size();
+                }
+            }
+        }};
+
+        {
+            std::vector<std::jthread> threads{};
+            for(std::size_t t{1}; t < num_threads; t++){
+                threads.emplace_back(run, t);
+            }
+            run(0);
+        }
+
+        if(failure){
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+// ============== END OF FILE ==============
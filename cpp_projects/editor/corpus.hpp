@@ -0,0 +1,53 @@
+/**
+ * corpus.hpp
+ * ----------
+ * Description:
+ *   Header file containing declarations for processing many text files at once.
+ * */
+
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "frequency_table.hpp"
+#include "ngram_table.hpp"
+#include "normalizer.hpp"
+#include "word_edits.hpp"
+
+namespace editor {
+    bool match_pattern(std::string_view pattern, std::string_view name);
+
+    class Corpus{
+    public:
+        explicit Corpus(const std::string& path);
+
+        const std::filesystem::path& root() const;
+
+        const std::vector<std::filesystem::path>& files() const;
+
+        FrequencyTable frequency_table(unsigned num_threads = 0) const;
+
+        NgramTable ngrams(std::size_t n, const WordEdits& edits, std::size_t max_entries = 0, unsigned num_threads = 0,
+                          const Normalizer* normalizer = nullptr) const;
+
+        void write(const WordEdits& edits, const std::filesystem::path& output, unsigned num_threads = 0,
+                   const Normalizer* normalizer = nullptr) const;
+
+    private:
+        std::filesystem::path _root;
+        std::vector<std::filesystem::path> _files;
+
+        std::size_t _thread_count(unsigned num_threads) const;
+
+        template<typename Work>
+        void _for_each_file(Work work, std::size_t num_threads) const;
+    };
+}
+
+#endif // CORPUS_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,86 @@
+#include "corpus.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+TEST_CASE("Test editor::match_pattern function"){
+    REQUIRE(editor::match_pattern("*.txt", "a.txt"));
+    REQUIRE(editor::match_pattern("*.txt", ".txt"));
+    REQUIRE_FALSE(editor::match_pattern("*.txt", "a.txt.gz"));
+    REQUIRE(editor::match_pattern("a?c*", "abc"));
+    REQUIRE(editor::match_pattern("a?c*", "axcdef"));
+    REQUIRE_FALSE(editor::match_pattern("a?c", "ac"));
+    REQUIRE(editor::match_pattern("*a*b*", "xxaybzz"));
+    REQUIRE_FALSE(editor::match_pattern("*a*b*", "xxbyazz"));
+    REQUIRE(editor::match_pattern("**", ""));
+    REQUIRE(editor::match_pattern("name", "name"));
+}
+
+TEST_CASE("Test editor::Corpus class"){
+    const std::filesystem::path root{std::filesystem::temp_directory_path() / "corpus_test"};
+    const std::filesystem::path output{std::filesystem::temp_directory_path() / "corpus_test_output"};
+    std::filesystem::remove_all(root);
+    std::filesystem::remove_all(output);
+    std::filesystem::create_directories(root / "nested");
+
+    std::vector<std::string> all_words{};
+    std::vector<std::filesystem::path> names{};
+    for(int f{0}; f < 40; f++){
+        const std::filesystem::path name{(f % 4 == 0 ? "nested/" : "") + std::string{"f"} + std::to_string(f) +
+                                         (f % 3 == 0 ? ".md" : ".txt")};
+        std::ofstream file{root / name};
+        for(int i{0}; i < f * 50; i++){
+            const std::string word{"w" + std::to_string((i * 13 + f) % 37)};
+            file << word << (i % 9 == 0 ? "\n" : " ");
+            all_words.push_back(word);
+        }
+        names.push_back(name);
+    }
+    std::ranges::sort(names);
+
+    const editor::Corpus corpus{root.string()};
+    REQUIRE(corpus.files() == names);
+
+    const editor::FrequencyTable expected{editor::create_frequency_table(all_words)};
+    REQUIRE(corpus.frequency_table(1) == expected);
+    REQUIRE(corpus.frequency_table(4) == expected);
+    REQUIRE(corpus.frequency_table(100) == expected);
+
+    // every file is edited and written under the output directory
+    editor::WordEdits edits{};
+    edits.remove("w3");
+    edits.substitute("w5", "five");
+    corpus.write(edits, output, 3);
+    for(const std::filesystem::path& name : names){
+        std::ifstream original{root / name};
+        std::vector<std::string> text{};
+        for(std::string word{}; original >> word;){
+            text.push_back(word);
+        }
+        edits.apply(text);
+
+        std::ostringstream printed{};
+        editor::print_text(text, printed);
+        std::ifstream written{output / name};
+        std::ostringstream content{};
+        content << written.rdbuf();
+        REQUIRE(content.str() == printed.str());
+    }
+    REQUIRE_THROWS_WITH(corpus.write(edits, root), "Directory `" + root.string() + "` would overwrite the corpus.");
+
+    // a pattern only takes the matching files of its directory
+    const editor::Corpus pattern{(root / "f1*.txt").string()};
+    REQUIRE(pattern.files() == std::vector<std::filesystem::path>{"f1.txt", "f10.txt", "f11.txt", "f13.txt", "f14.txt",
+                                                                  "f17.txt", "f19.txt"});
+
+    const editor::Corpus single{(root / "f1.txt").string()};
+    REQUIRE(single.files() == std::vector<std::filesystem::path>{"f1.txt"});
+
+    REQUIRE_THROWS_WITH(editor::Corpus{(root / "*.none").string()},
+                        "No files found at `" + (root / "*.none").string() + "`.");
+
+    std::filesystem::remove_all(root);
+    std::filesystem::remove_all(output);
+}
@@ -0,0 +1,444 @@
+/**
+ * document.cpp
+ * ------------
+ * Description:
+ *
+ *     ----- Document -----
+ *
+ *  An editable sequence of words, stored as a piece table: the words are kept in
+ *  arrays that never change once written, and the document is a sequence of pieces,
+ *  each a range of one of those arrays. Loading a text creates a single piece, and
+ *  an edit at a position only splits and joins pieces, so it never copies the words
+ *  themselves. Removing or substituting a word rebuilds only the pieces containing it.
+ *
+ *  The pieces are the nodes of a treap ordered by position, where every node knows
+ *  the number of words below it, so that finding, inserting and erasing at a position
+ *  takes expected O(log number of pieces). Nodes are never modified: an edit copies
+ *  the O(log n) nodes on the paths it changes and shares all others with the previous
+ *  version. Every version is thereby a snapshot, kept as the root of its tree, and
+ *  undo and redo only swap roots. The pieces share ownership of their arrays, so an
+ *  array is released once no version uses it anymore.
+ *
+ *  Positions are counted in words, starting at 0.
+ *
+ **/
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "document.hpp"
+#include "editor.hpp"
+#include "output_buffer.hpp"
+#include "tokenizer.hpp"
+
+namespace editor {
+    // a range of words of one of the arrays of the document, which it keeps alive.
+    struct Piece{
+        std::shared_ptr<const std::vector<std::string_view>> array;
+        const std::string_view* words;
+        std::size_t count;
+    };
+
+    struct Document::Node{
+        NodePtr left;
+        NodePtr right;
+        Piece piece;
+        std::size_t size;           // number of words in the subtree
+        std::uint32_t priority;
+    };
+
+    namespace helper {
+        using Node = Document::Node;
+        using NodePtr = std::shared_ptr<const Node>;
+
+        std::out_of_range not_in_document(const std::size_t position){
+            return std::out_of_range("Position " + std::to_string(position) + " is not in the document.");
+        }
+
+        std::size_t size(const NodePtr& node){
+            return node ? node->size : 0;
+        }
+
+        NodePtr make_node(NodePtr left, NodePtr right, Piece piece, const std::uint32_t priority){
+            const std::size_t total{size(left) + piece.count + size(right)};
+            return std::make_shared<const Node>(Node{std::move(left), std::move(right), std::move(piece), total,
+                                                     priority});
+        }
+
+        /**
+         * @brief Split a tree into the trees of its first k words and of the rest.
+         *
+         * A piece containing the split position is cut into two pieces of the same array.
+         */
+        std::pair<NodePtr, NodePtr> split(const NodePtr& node, const std::size_t k){
+            if(!node){
+                return {};
+            }
+
+            const std::size_t left_size{size(node->left)};
+            const Piece& piece{node->piece};
+
+            if(k <= left_size){
+                auto [first, second]{split(node->left, k)};
+                return {std::move(first), make_node(std::move(second), node->right, piece, node->priority)};
+            }
+            if(k >= left_size + piece.count){
+                auto [first, second]{split(node->right, k - left_size - piece.count)};
+                return {make_node(node->left, std::move(first), piece, node->priority), std::move(second)};
+            }
+
+            // both halves keep the priority of the node, which is at least that of their children.
+            const std::size_t offset{k - left_size};
+            return {make_node(node->left, nullptr, Piece{piece.array, piece.words, offset}, node->priority),
+                    make_node(nullptr, node->right, Piece{piece.array, piece.words + offset, piece.count - offset},
+                              node->priority)};
+        }
+
+        // join two trees, all words of the first one coming before those of the second one.
+        NodePtr merge(const NodePtr& first, const NodePtr& second){
+            if(!first){
+                return second;
+            }
+            if(!second){
+                return first;
+            }
+
+            if(first->priority > second->priority){
+                return make_node(first->left, merge(first->right, second), first->piece, first->priority);
+            }
+            return make_node(merge(first, second->left), second->right, second->piece, second->priority);
+        }
+
+        /**
+         * @brief Edit the pieces of a tree that contain a word, sharing all other nodes.
+         *
+         * The words of each such piece are copied into a new array and edited there.
+         * A piece left without words is dropped.
+         *
+         * @param node: the tree.
+         * @param word: the word to look for.
+         * @param edit: function editing a vector of words in place and returning it.
+         * @return the edited tree, which is the same tree if no piece contains the word.
+         */
+        template<typename Edit>
+        NodePtr edit_pieces(const NodePtr& node, const std::string_view word, const Edit& edit){
+            if(!node){
+                return nullptr;
+            }
+
+            NodePtr left{edit_pieces(node->left, word, edit)};
+            NodePtr right{edit_pieces(node->right, word, edit)};
+            const Piece& piece{node->piece};
+            const std::string_view* const end{piece.words + piece.count};
+
+            if(std::find(piece.words, end, word) == end){
+                if(left == node->left && right == node->right){
+                    return node;
+                }
+                return make_node(std::move(left), std::move(right), piece, node->priority);
+            }
+
+            auto array{std::make_shared<const std::vector<std::string_view>>(
+                edit(std::vector<std::string_view>(piece.words, end)))};
+            // the children have priorities of at most that of the node, so they can replace it.
+            if(array->empty()){
+                return merge(left, right);
+            }
+            const Piece edited{array, array->data(), array->size()};
+            return make_node(std::move(left), std::move(right), edited, node->priority);
+        }
+    }
+
+    // ------------------- ITERATOR -------------------
+
+    Document::const_iterator::const_iterator()
+        : _stack{}, _offset{0}
+        {}
+
+    std::string_view Document::const_iterator::operator*() const{
+        return _stack.back()->piece.words[_offset];
+    }
+
+    Document::const_iterator& Document::const_iterator::operator++(){
+        const Node* node{_stack.back()};
+        if(++_offset == node->piece.count){
+            _stack.pop_back();
+            _offset = 0;
+            _descend(node->right.get());
+        }
+        return *this;
+    }
+
+    Document::const_iterator Document::const_iterator::operator++(int){
+        const_iterator previous{*this};
+        ++*this;
+        return previous;
+    }
+
+    bool Document::const_iterator::operator==(const const_iterator& other) const{
+        if(_stack.empty() || other._stack.empty()){
+            return _stack.empty() && other._stack.empty();
+        }
+        return _stack.back() == other._stack.back() && _offset == other._offset;
+    }
+
+    // go to the first piece of a subtree.
+    void Document::const_iterator::_descend(const Node* node){
+        for(; node; node = node->left.get()){
+            _stack.push_back(node);
+        }
+    }
+
+    // ------------------- DOCUMENT -------------------
+
+    Document::Document()
+        : _root{}, _undo{}, _redo{}, _texts{}, _random{}
+        {}
+
+    /**
+     * @brief Create a document of the words of a text.
+     *
+     * @param text: the text, split into words at whitespace.
+     */
+    Document::Document(std::string text)
+        : _root{}, _undo{}, _redo{}, _texts{}, _random{}
+    {
+        const std::string& owned{_texts.emplace_back(std::move(text))};
+        _root = _piece(split_words(owned));
+    }
+
+    std::size_t Document::size() const{
+        return helper::size(_root);
+    }
+
+    /**
+     * @brief Find the word at a position, in expected O(log number of pieces).
+     *
+     * @param position: position of the word.
+     * @return the word.
+     * @throws std::out_of_range if there is no word at the position.
+     */
+    std::string_view Document::at(std::size_t position) const{
+        if(position >= size()){
+            throw helper::not_in_document(position);
+        }
+
+        const Node* node{_root.get()};
+        while(true){
+            const std::size_t left_size{helper::size(node->left)};
+            if(position < left_size){
+                node = node->left.get();
+            }
+            else if(position < left_size + node->piece.count){
+                return node->piece.words[position - left_size];
+            }
+            else{
+                position -= left_size + node->piece.count;
+                node = node->right.get();
+            }
+        }
+    }
+
+    /**
+     * @brief Insert words before a position, as one edit.
+     *
+     * @param position: position of the first inserted word, at most the size of the document.
+     * @param words: the words to insert, which the document copies.
+     * @throws std::out_of_range if the position is past the end of the document.
+     */
+    void Document::insert(const std::size_t position, const std::vector<std::string_view>& words){
+        _check(position);
+        if(words.empty()){
+            return;
+        }
+
+        auto [first, second]{helper::split(_root, position)};
+        _commit(helper::merge(helper::merge(first, _own(words)), second));
+    }
+
+    /**
+     * @brief Erase words starting at a position, as one edit.
+     *
+     * @param position: position of the first erased word.
+     * @param count: number of words to erase, fewer if the document ends before.
+     * @throws std::out_of_range if the position is past the end of the document.
+     */
+    void Document::erase(const std::size_t position, const std::size_t count){
+        _check(position);
+        if(count == 0 || position == size()){
+            return;
+        }
+
+        auto [first, rest]{helper::split(_root, position)};
+        auto [erased, second]{helper::split(rest, count)};
+        _commit(helper::merge(first, second));
+    }
+
+    /**
+     * @brief Replace the word at a position with another word, as one edit.
+     *
+     * @param position: position of the word.
+     * @param word: the new word.
+     * @throws std::out_of_range if there is no word at the position.
+     */
+    void Document::replace(const std::size_t position, const std::string_view word){
+        at(position);
+
+        auto [first, rest]{helper::split(_root, position)};
+        auto [replaced, second]{helper::split(rest, 1)};
+        _commit(helper::merge(helper::merge(first, _own({word})), second));
+    }
+
+    /**
+     * @brief Remove all occurrences of a word, as one edit.
+     *
+     * This looks at every word, so it takes O(number of words), but only copies
+     * the pieces containing the word.
+     *
+     * @param word: the word to remove.
+     */
+    void Document::remove_word(const std::string_view word){
+        _commit(helper::edit_pieces(_root, word, [word](std::vector<std::string_view>&& piece){
+            return editor::remove_word(std::move(piece), word);
+        }));
+    }
+
+    /**
+     * @brief Substitute all occurrences of a word with another word, as one edit.
+     *
+     * This looks at every word, so it takes O(number of words), but only copies
+     * the pieces containing the old word.
+     *
+     * @param old_word: the word to be replaced.
+     * @param new_word: the word to replace old word with.
+     */
+    void Document::substitute_word(const std::string_view old_word, const std::string_view new_word){
+        const std::string_view owned{_texts.emplace_back(new_word)};
+        _commit(helper::edit_pieces(_root, old_word, [old_word, owned](std::vector<std::string_view>&& piece){
+            return editor::substitute_word(std::move(piece), old_word, owned);
+        }));
+    }
+
+    /**
+     * @brief Go back to the version before the last edit.
+     *
+     * @return whether there was an edit to undo.
+     */
+    bool Document::undo(){
+        if(_undo.empty()){
+            return false;
+        }
+        _redo.push_back(std::exchange(_root, std::move(_undo.back())));
+        _undo.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Go forward to the version of the last undone edit.
+     *
+     * @return whether there was an undone edit to redo.
+     */
+    bool Document::redo(){
+        if(_redo.empty()){
+            return false;
+        }
+        _undo.push_back(std::exchange(_root, std::move(_redo.back())));
+        _redo.pop_back();
+        return true;
+    }
+
+    // views of all words of the document, valid as long as the document.
+    std::vector<std::string_view> Document::words() const{
+        std::vector<std::string_view> result{};
+        result.reserve(size());
+        result.insert(result.end(), begin(), end());
+        return result;
+    }
+
+    Document::const_iterator Document::begin() const{
+        const_iterator it{};
+        it._descend(_root.get());
+        return it;
+    }
+
+    Document::const_iterator Document::end() const{
+        return const_iterator{};
+    }
+
+    // ------------------- PRIVATE FUNCTIONS -------------------
+
+    // create a tree of a single piece of an array of words.
+    Document::NodePtr Document::_piece(std::vector<std::string_view> words){
+        if(words.empty()){
+            return nullptr;
+        }
+        auto array{std::make_shared<const std::vector<std::string_view>>(std::move(words))};
+        Piece piece{array, array->data(), array->size()};
+        return helper::make_node(nullptr, nullptr, std::move(piece), _random());
+    }
+
+    // make a new version the current one, which is undone to the previous one.
+    void Document::_commit(NodePtr root){
+        _undo.push_back(std::exchange(_root, std::move(root)));
+        _redo.clear();
+    }
+
+    // copy words into the document, and create a tree of a single piece of them.
+    Document::NodePtr Document::_own(const std::vector<std::string_view>& words){
+        std::string& text{_texts.emplace_back()};
+        std::size_t length{0};
+        for(const std::string_view word : words){
+            length += word.size();
+        }
+        text.reserve(length);
+        for(const std::string_view word : words){
+            text.append(word);
+        }
+
+        std::vector<std::string_view> owned{};
+        owned.reserve(words.size());
+        std::size_t begin{0};
+        for(const std::string_view word : words){
+            owned.emplace_back(text.data() + begin, word.size());
+            begin += word.size();
+        }
+        return _piece(std::move(owned));
+    }
+
+    void Document::_check(const std::size_t position) const{
+        if(position > size()){
+            throw helper::not_in_document(position);
+        }
+    }
+
+    // ------------------- FREE FUNCTIONS -------------------
+
+    /**
+     * @brief Print all words of a document, separated by space.
+     *
+     * @param document: the document.
+     * @param os: an output stream, by default std::cout is used.
+     */
+    void print_text(const Document& document, std::ostream& os){
+        {
+            OutputBuffer output{os};
+            for(const std::string_view word : document){
+                output.write(word);
+                output.write(' ');
+            }
+        }
+        os << std::endl;
+    }
+
+    /**
+     * @brief Create a frequency table of the words of a document.
+     *
+     * @param document: the document.
+     * @return a table of words and their frequencies.
+     */
+    FrequencyTable create_frequency_table(const Document& document){
+        return create_frequency_table(document.words());
+    }
+}
+
+// ============== END OF FILE ==============
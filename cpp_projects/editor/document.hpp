@@ -0,0 +1,116 @@
+/**
+ * document.hpp
+ * ------------
+ * Description:
+ *   Header file containing declarations for the editable document of words.
+ * */
+
+#ifndef DOCUMENT_HPP
+#define DOCUMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "frequency_table.hpp"
+
+namespace editor {
+    class Document{
+    public:
+        // a node of the tree of pieces, only known to the implementation.
+        struct Node;
+        using NodePtr = std::shared_ptr<const Node>;
+
+        class const_iterator{
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+            using pointer = void;
+            using iterator_category = std::forward_iterator_tag;
+
+            const_iterator();
+
+            std::string_view operator*() const;
+
+            const_iterator& operator++();
+
+            const_iterator operator++(int);
+
+            bool operator==(const const_iterator& other) const;
+
+        private:
+            friend class Document;
+
+            // the nodes whose pieces are not passed yet, the current one on top.
+            std::vector<const Node*> _stack;
+            std::size_t _offset;
+
+            void _descend(const Node* node);
+        };
+
+        Document();
+
+        explicit Document(std::string text);
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        Document(Document&&) noexcept = default;
+        Document& operator=(Document&&) noexcept = default;
+
+        ~Document() = default;
+
+        std::size_t size() const;
+
+        std::string_view at(std::size_t position) const;
+
+        void insert(std::size_t position, const std::vector<std::string_view>& words);
+
+        void erase(std::size_t position, std::size_t count = 1);
+
+        void replace(std::size_t position, std::string_view word);
+
+        void remove_word(std::string_view word);
+
+        void substitute_word(std::string_view old_word, std::string_view new_word);
+
+        bool undo();
+
+        bool redo();
+
+        std::vector<std::string_view> words() const;
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+    private:
+        NodePtr _root;
+        std::vector<NodePtr> _undo;
+        std::vector<NodePtr> _redo;
+
+        // the loaded text and the copies of inserted words, which the arrays of words view.
+        std::deque<std::string> _texts;
+        std::mt19937 _random;
+
+        NodePtr _piece(std::vector<std::string_view> words);
+        void _commit(NodePtr root);
+        NodePtr _own(const std::vector<std::string_view>& words);
+        void _check(std::size_t position) const;
+    };
+
+    void print_text(const Document& document, std::ostream& os = std::cout);
+
+    FrequencyTable create_frequency_table(const Document& document);
+}
+
+#endif // DOCUMENT_HPP
+
+// ============== END OF FILE ==============
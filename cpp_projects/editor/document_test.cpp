@@ -0,0 +1,158 @@
+#include "document.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+    std::vector<std::string> as_strings(const editor::Document& document){
+        std::vector<std::string> result{};
+        for(const std::string_view word : document){
+            result.emplace_back(word);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Test editor::Document editing at positions"){
+    editor::Document document{"the quick brown fox"};
+    REQUIRE(document.size() == 4);
+    REQUIRE(document.at(2) == "brown");
+    REQUIRE_THROWS_WITH(document.at(4), "Position 4 is not in the document.");
+
+    document.insert(1, {"very", "very"});
+    document.erase(3);
+    document.replace(0, "a");
+    document.insert(document.size(), {"jumps"});
+    REQUIRE(as_strings(document) == std::vector<std::string>{"a", "very", "very", "brown", "fox", "jumps"});
+    REQUIRE_THROWS_WITH(document.insert(7, {"x"}), "Position 7 is not in the document.");
+
+    // erasing past the end stops at the end
+    document.erase(4, 10);
+    REQUIRE(as_strings(document) == std::vector<std::string>{"a", "very", "very", "brown"});
+
+    std::ostringstream os{};
+    editor::print_text(document, os);
+    REQUIRE(os.str() == "a very very brown \n");
+
+    const editor::FrequencyTable table{editor::create_frequency_table(document)};
+    REQUIRE(table.at("very") == 2);
+    REQUIRE(table.size() == 3);
+
+    editor::Document empty{};
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.begin() == empty.end());
+    REQUIRE_FALSE(empty.undo());
+}
+
+TEST_CASE("Test editor::Document undoing and redoing edits"){
+    editor::Document document{"a b c a d"};
+    const std::vector<std::string> original{"a", "b", "c", "a", "d"};
+
+    document.substitute_word("a", "x");
+    document.remove_word("c");
+    document.replace(1, "y");
+    REQUIRE(as_strings(document) == std::vector<std::string>{"x", "y", "x", "d"});
+
+    REQUIRE(document.undo());
+    REQUIRE(as_strings(document) == std::vector<std::string>{"x", "b", "x", "d"});
+    REQUIRE(document.undo());
+    REQUIRE(document.undo());
+    REQUIRE_FALSE(document.undo());
+    REQUIRE(as_strings(document) == original);
+
+    REQUIRE(document.redo());
+    REQUIRE(as_strings(document) == std::vector<std::string>{"x", "b", "c", "x", "d"});
+
+    // a new edit forgets the undone ones
+    document.erase(0, 2);
+    REQUIRE_FALSE(document.redo());
+    REQUIRE(as_strings(document) == std::vector<std::string>{"c", "x", "d"});
+    REQUIRE(document.undo());
+    REQUIRE(document.undo());
+    REQUIRE(as_strings(document) == original);
+}
+
+TEST_CASE("Test editor::Document editing words across pieces"){
+    editor::Document document{"a b a"};
+    document.insert(1, {"a", "a"});
+    document.insert(document.size(), {"c", "a"});
+    document.replace(0, "b");
+    const std::vector<std::string> before{"b", "a", "a", "b", "a", "c", "a"};
+    REQUIRE(as_strings(document) == before);
+
+    // the piece of the two inserted words is left without words
+    document.remove_word("a");
+    REQUIRE(as_strings(document) == std::vector<std::string>{"b", "b", "c"});
+    REQUIRE(document.at(2) == "c");
+
+    REQUIRE(document.undo());
+    REQUIRE(as_strings(document) == before);
+    document.substitute_word("a", "xy");
+    REQUIRE(as_strings(document) == std::vector<std::string>{"b", "xy", "xy", "b", "xy", "c", "xy"});
+
+    // a word that is not in the document changes nothing, but is still an edit
+    document.remove_word("z");
+    REQUIRE(document.size() == 7);
+    REQUIRE(document.undo());
+    REQUIRE(document.undo());
+    REQUIRE(as_strings(document) == before);
+}
+
+TEST_CASE("Test editor::Document against a vector of words"){
+    std::string text{};
+    for(int i{0}; i < 2000; i++){
+        text += "w" + std::to_string(i % 97) + " ";
+    }
+    editor::Document document{text};
+    std::vector<std::string> expected{as_strings(document)};
+    std::vector<std::vector<std::string>> versions{expected};
+
+    std::mt19937 random{7};
+    for(int i{0}; i < 500; i++){
+        const std::size_t position{random() % (expected.size() + 1)};
+        const std::string word{"n" + std::to_string(i)};
+
+        switch(random() % 3){
+            case 0:
+                document.insert(position, {word, "z"});
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(position), {word, "z"});
+                break;
+            case 1:{
+                const std::size_t count{std::min<std::size_t>(random() % 5, expected.size() - position)};
+                if(count == 0){
+                    // erasing nothing is not an edit
+                    continue;
+                }
+                document.erase(position, count);
+                const auto first{expected.begin() + static_cast<std::ptrdiff_t>(position)};
+                expected.erase(first, first + static_cast<std::ptrdiff_t>(count));
+                break;
+            }
+            default:
+                if(position == expected.size()){
+                    continue;
+                }
+                document.replace(position, word);
+                expected[position] = word;
+        }
+        versions.push_back(expected);
+
+        const std::size_t probe{random() % expected.size()};
+        REQUIRE(document.at(probe) == expected[probe]);
+    }
+    REQUIRE(document.size() == expected.size());
+    REQUIRE(as_strings(document) == expected);
+
+    // every version is a snapshot that is still there
+    for(auto version{versions.rbegin() + 1}; version != versions.rend(); version++){
+        REQUIRE(document.undo());
+        REQUIRE(as_strings(document) == *version);
+    }
+    REQUIRE_FALSE(document.undo());
+    while(document.redo()){}
+    REQUIRE(as_strings(document) == expected);
+}
+
+// ============== END OF FILE ==============
@@ -15,8 +15,29 @@
  *   --print: will print the text on the console.
  *   --frequency: will print each word and their count in descending order.
  *   --table: similar as `--frequency`, but sorted in lexicographic order.
+ *   --top=<k>: similar as `--frequency`, but only the k most frequent words.
  *   --substitute=<old>+<new>: replace all occurrences of `old` with `new`.
+ *   --substitute-file=<rules>: apply all substitutions of a file of rules at once,
+ *                              one `<old> <new>` pair per line.
  *   --remove=<word>: remove all occurrences of `word` in the text.
+ *   --remove-regex=<re>: remove all words that match the regular expression `re`.
+ *   --substitute-regex=<re>+<new>: replace all words that match the regular expression
+ *                                  `re` with `new`, which follows the last `+`.
+ *   --mmap: memory-map the file instead of reading it into memory, and work on
+ *           views of its words.
+ *   --stream=<file>: read the file in chunks, without holding the text in memory,
+ *                    and write the printed text to `file`.
+ *   --corpus=<dir>: the path is a directory or a pattern of file names in a
+ *                   directory, such as `*.txt`, whose files are processed in
+ *                   parallel, and the printed text of every file is written to `dir`.
+ *   --build-index=<file>: write an index of the words of the text to `file`.
+ *   --index: the file to read is an index written by `--build-index`, whose
+ *            frequency table is read instead of counting the text.
+ *   --positions=<word>: print the positions of `word` in the indexed text.
+ *   --ngrams=<n>[+<k>]: print the counts of the sequences of n consecutive words,
+ *                       from 1 to 4, sorted like `--frequency`, or only the k most frequent.
+ *   --normalize: fold the case of all words and strip the punctuation around them,
+ *                before any other operation.
  * 
  * Example command:
  *   `$ ./edit.out some_file.txt --substitute=the+WORD --print`
@@ -24,9 +45,348 @@
  **/
 
 #include <fstream>
-#include <iterator>
+#include <sstream>
 #include <algorithm>
+#include <limits>
+#include <optional>
+#include "corpus.hpp"
 #include "editor.hpp"
+#include "mapped_file.hpp"
+#include "ngram_table.hpp"
+#include "normalizer.hpp"
+#include "tokenizer.hpp"
+#include "word_edits.hpp"
+#include "word_index.hpp"
+#include "word_pattern.hpp"
+#include "word_stream.hpp"
+
+/**
+ * @brief Read the substitution rules of a file, stopping the program if they are invalid.
+ *
+ * @param path: path to the file of rules.
+ * @return the rules.
+ */
+editor::SubstitutionRules load_substitution_rules(const std::string& path){
+    std::ifstream file{path};
+    if (!file.is_open()) {
+        std::cerr << "ERROR: File `" << path << "` not found." << std::endl;
+        std::terminate();
+    }
+
+    try {
+        return editor::read_substitution_rules(file);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "ERROR: " << path << ": " << e.what() << std::endl;
+        std::terminate();
+    }
+}
+
+/**
+ * @brief Compile the pattern of an argument, stopping the program if it is invalid.
+ *
+ * @param pattern: the regular expression.
+ * @return the compiled pattern.
+ */
+editor::WordPattern compile_pattern(const std::string& pattern){
+    try {
+        return editor::WordPattern{pattern};
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        std::terminate();
+    }
+}
+
+// number of distinct n-grams above which texts that are not held in memory drop the less frequent ones.
+constexpr std::size_t max_ngram_entries{1 << 22};
+
+/**
+ * @brief Get the number of n-grams to print of an `--ngrams` argument.
+ *
+ * @param arg_parts: the parts of the argument.
+ * @return the given number, or all n-grams if none is given.
+ */
+std::size_t ngrams_to_print(const std::vector<std::string>& arg_parts){
+    return arg_parts.at(2).empty() ? std::numeric_limits<std::size_t>::max() : std::stoul(arg_parts.at(2));
+}
+
+/**
+ * @brief Stop the program for an operation that a mode cannot perform.
+ *
+ * @param flag: the flag of the operation.
+ * @param reason: why it cannot be performed.
+ */
+[[noreturn]] void unsupported(const std::string& flag, const std::string& reason){
+    std::cerr << "ERROR: `" << flag << "` " << reason << std::endl;
+    std::terminate();
+}
+
+/**
+ * @brief Normalize the words of a frequency table, if a normalizer is given.
+ *
+ * @param table: a table of words and their frequencies.
+ * @param normalizer: the normalizer, or nullptr to keep the words as they are.
+ * @return the table of the normalized words.
+ */
+editor::FrequencyTable normalized(editor::FrequencyTable table, editor::Normalizer* normalizer){
+    if (normalizer) {
+        return normalizer->apply(table);
+    }
+    return table;
+}
+
+/**
+ * @brief Perform the operations given by the arguments, in order, however the text is held.
+ *
+ * Removals and substitutions are only combined into pending edits. The text is
+ * only edited when it is printed, and the frequency table is only counted when it
+ * is first printed and then kept up to date by moving the counts of the edited words.
+ * Edits of the words matching a pattern match each distinct word of the current
+ * frequency table once, and become removals or substitutions of the matching words.
+ *
+ * @param arguments: all command-line arguments.
+ * @param count_table: returns the frequency table of the text, without any edits.
+ * @param print: prints the text with the pending text edits, which it may apply and clear.
+ * @param other: performs the operations of a single mode, given the argument parts and the pending text edits.
+ */
+template<typename CountTable, typename Print, typename Other>
+void perform_operations(const std::vector<std::string>& arguments, CountTable count_table, Print print, Other other){
+    // the edits own the substituted words, so they must outlive the text.
+    editor::WordEdits text_edits{};
+    editor::WordEdits table_edits{};
+    std::optional<editor::FrequencyTable> table{};
+
+    const auto current_table{[&]() -> const editor::FrequencyTable& {
+        if(!table){
+            table = count_table();
+            text_edits.apply(*table);
+        }
+        else{
+            table_edits.apply(*table);
+        }
+        table_edits.clear();
+        return *table;
+    }};
+
+    std::ranges::for_each(arguments, [&](const std::string& arg) {
+    // parse the argument to get the parts
+    const std::vector<std::string> arg_parts{editor::parse_argument(arg)};
+    const std::string& flag{arg_parts.at(0)};
+
+    if (flag == "--help") {
+        editor::print_help();
+    } else if (flag == "--print") {
+        print(text_edits);
+    } else if (flag == "--table") {
+        editor::print_table(current_table());
+    } else if (flag == "--frequency") {
+        editor::print_frequency(current_table());
+    } else if (flag == "--top") {
+        editor::print_top(current_table(), std::stoul(arg_parts.at(1)));
+    } else if (flag == "--remove") {
+        const std::string& word{arg_parts.at(1)};
+        text_edits.remove(word);
+        if (table) {
+            table_edits.remove(word);
+        }
+    } else if (flag == "--substitute") {
+        const std::string& old_word{arg_parts.at(1)};
+        const std::string& new_word{arg_parts.at(2)};
+        text_edits.substitute(old_word, new_word);
+        if (table) {
+            table_edits.substitute(old_word, new_word);
+        }
+    } else if (flag == "--remove-regex") {
+        const editor::WordPattern pattern{compile_pattern(arg_parts.at(1))};
+        const std::vector<std::string_view> words{editor::matching_words(current_table(), pattern)};
+        text_edits.remove(words);
+        table_edits.remove(words);
+    } else if (flag == "--substitute-regex") {
+        editor::SubstitutionRules rules{};
+        for (const std::string_view word : editor::matching_words(current_table(), compile_pattern(arg_parts.at(1)))) {
+            rules.emplace_back(word, arg_parts.at(2));
+        }
+        text_edits.substitute(rules);
+        table_edits.substitute(rules);
+    } else if (flag == "--substitute-file") {
+        const editor::SubstitutionRules rules{load_substitution_rules(arg_parts.at(1))};
+        text_edits.substitute(rules);
+        if (table) {
+            table_edits.substitute(rules);
+        }
+    } else {
+        other(arg_parts, text_edits);
+    }
+    });
+}
+
+/**
+ * @brief Perform the operations given by the arguments on a text, in order.
+ *
+ * The text is edited in one pass when it is printed or indexed.
+ *
+ * @param text: vector of words, either strings or views of words.
+ * @param arguments: all command-line arguments.
+ */
+template<typename Word>
+void run_operations(std::vector<Word>& text, const std::vector<std::string>& arguments){
+    perform_operations(arguments,
+        [&text]() {
+            return editor::create_frequency_table(text);
+        },
+        [&text](editor::WordEdits& edits) {
+            edits.apply(text);
+            edits.clear();
+            editor::print_text(text);
+        },
+        [&text](const std::vector<std::string>& arg_parts, editor::WordEdits& edits) {
+            if (arg_parts.at(0) == "--build-index") {
+                edits.apply(text);
+                edits.clear();
+                editor::write_word_index(text, arg_parts.at(1));
+            } else if (arg_parts.at(0) == "--ngrams") {
+                edits.apply(text);
+                edits.clear();
+                editor::print_ngrams(editor::count_ngrams(text, std::stoul(arg_parts.at(1))),
+                                     ngrams_to_print(arg_parts));
+            } else if (arg_parts.at(0) == "--positions") {
+                unsupported(arg_parts.at(0), "needs an index of the text, given with `--index`.");
+            }
+        });
+}
+
+/**
+ * @brief Perform the operations given by the arguments on a text file, one chunk at a time.
+ *
+ * The text is never held in memory. Printing reads the file again and writes the
+ * edited text to the output file, and the frequency table is counted while reading
+ * the file once.
+ *
+ * @param path: path to the text file.
+ * @param output_path: path to the file that the printed text is written to.
+ * @param arguments: all command-line arguments.
+ * @param normalizer: normalizes the words, if given.
+ */
+void stream_operations(const std::string& path, const std::string& output_path,
+                       const std::vector<std::string>& arguments, editor::Normalizer* normalizer){
+    std::ofstream output{output_path};
+    if (!output.is_open()) {
+        std::cerr << "ERROR: File `" << output_path << "` cannot be written." << std::endl;
+        std::terminate();
+    }
+
+    const auto open_text{[&path]() {
+        std::ifstream file{path, std::ios::binary};
+        if (!file.is_open()) {
+            std::cerr << "ERROR: File `" << path << "` not found." << std::endl;
+            std::terminate();
+        }
+        return file;
+    }};
+
+    perform_operations(arguments,
+        [&open_text, normalizer]() {
+            std::ifstream file{open_text()};
+            return normalized(editor::stream_frequency_table(file), normalizer);
+        },
+        [&open_text, &output, normalizer](editor::WordEdits& edits) {
+            std::ifstream file{open_text()};
+            editor::stream_text(file, edits, output, normalizer);
+        },
+        [&open_text, normalizer](const std::vector<std::string>& arg_parts, editor::WordEdits& edits) {
+            if (arg_parts.at(0) == "--ngrams") {
+                editor::NgramTable table{std::stoul(arg_parts.at(1)), max_ngram_entries};
+                std::ifstream file{open_text()};
+                table.add(file, edits, normalizer);
+                editor::print_ngrams(table, ngrams_to_print(arg_parts));
+            } else if (arg_parts.at(0) == "--build-index") {
+                unsupported(arg_parts.at(0), "needs the whole text, it cannot be combined with `--stream`.");
+            } else if (arg_parts.at(0) == "--positions") {
+                unsupported(arg_parts.at(0), "needs an index of the text, given with `--index`.");
+            }
+        });
+}
+
+/**
+ * @brief Perform the operations given by the arguments on all files of a corpus.
+ *
+ * The files are processed in parallel, and are read again for every operation
+ * instead of being held in memory. Printing writes every edited file to the
+ * output directory, under the same relative path.
+ *
+ * @param path: a directory, or a pattern of file names in a directory.
+ * @param output_path: path to the directory that the printed files are written to.
+ * @param arguments: all command-line arguments.
+ * @param normalizer: normalizes the words, if given.
+ */
+void corpus_operations(const std::string& path, const std::string& output_path,
+                       const std::vector<std::string>& arguments, editor::Normalizer* normalizer){
+    try {
+        const editor::Corpus corpus{path};
+
+        perform_operations(arguments,
+            [&corpus, normalizer]() {
+                return normalized(corpus.frequency_table(), normalizer);
+            },
+            [&corpus, &output_path, normalizer](editor::WordEdits& edits) {
+                corpus.write(edits, output_path, 0, normalizer);
+            },
+            [&corpus, normalizer](const std::vector<std::string>& arg_parts, editor::WordEdits& edits) {
+                if (arg_parts.at(0) == "--ngrams") {
+                    editor::print_ngrams(corpus.ngrams(std::stoul(arg_parts.at(1)), edits, max_ngram_entries, 0,
+                                                       normalizer),
+                                         ngrams_to_print(arg_parts));
+                } else if (arg_parts.at(0) == "--build-index") {
+                    unsupported(arg_parts.at(0), "needs a single text, it cannot be combined with `--corpus`.");
+                } else if (arg_parts.at(0) == "--positions") {
+                    unsupported(arg_parts.at(0), "needs an index of the text, given with `--index`.");
+                }
+            });
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        std::terminate();
+    }
+}
+
+/**
+ * @brief Perform the operations given by the arguments on an index of a text.
+ *
+ * The frequency table is read from the index instead of counting the text, and the
+ * positions of words are listed from it, so no pass over the text is made.
+ *
+ * @param path: path to the index file.
+ * @param arguments: all command-line arguments.
+ * @param normalizer: normalizes the words of the frequency table, if given.
+ */
+void index_operations(const std::string& path, const std::vector<std::string>& arguments,
+                      editor::Normalizer* normalizer){
+    try {
+        const editor::WordIndex index{path};
+
+        perform_operations(arguments,
+            [&index, normalizer]() {
+                return normalized(index.frequency_table(), normalizer);
+            },
+            [](editor::WordEdits&) {
+                unsupported("--print", "needs the text file, not an index.");
+            },
+            [&index](const std::vector<std::string>& arg_parts, editor::WordEdits&) {
+                if (arg_parts.at(0) == "--build-index" || arg_parts.at(0) == "--ngrams") {
+                    unsupported(arg_parts.at(0), "needs the text file, not an index.");
+                } else if (arg_parts.at(0) == "--positions") {
+                    const std::optional<std::size_t> id{index.find(arg_parts.at(1))};
+                    editor::print_positions(arg_parts.at(1), id ? index.positions(*id)
+                                                                : std::vector<std::uint64_t>{});
+                }
+            });
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        std::terminate();
+    }
+}
 
 int main(int argc, char** argv){
     // parse arguments into a vector for easier management
@@ -48,9 +408,44 @@ int main(int argc, char** argv){
       }
     });
 
+    // the normalizer owns the normalized words, so it must outlive the text.
+    std::optional<editor::Normalizer> normalizer{};
+    if(std::ranges::find(arguments, "--normalize") != arguments.end()) {
+        normalizer.emplace();
+    }
+    editor::Normalizer* const normalize{normalizer ? &*normalizer : nullptr};
+
     if(argc == 2 && arguments.at(1) == "--help") {
         editor::print_help();
     }
+    else if(std::ranges::find(arguments, "--index") != arguments.end()) {
+        index_operations(arguments.at(1), arguments, normalize);
+    }
+    else if(const auto corpus{std::ranges::find_if(arguments, [](const std::string& arg) {
+                return editor::parse_argument(arg).at(0) == "--corpus";
+            })}; corpus != arguments.end()) {
+        corpus_operations(arguments.at(1), editor::parse_argument(*corpus).at(1), arguments, normalize);
+    }
+    else if(const auto stream{std::ranges::find_if(arguments, [](const std::string& arg) {
+                return editor::parse_argument(arg).at(0) == "--stream";
+            })}; stream != arguments.end()) {
+        stream_operations(arguments.at(1), editor::parse_argument(*stream).at(1), arguments, normalize);
+    }
+    else if(std::ranges::find(arguments, "--mmap") != arguments.end()) {
+        // the mapping must outlive all views of its words.
+        try {
+            const editor::MappedFile file{arguments.at(1)};
+            std::vector<std::string_view> text{editor::split_words(file.view())};
+            if (normalize) {
+                normalize->apply(text);
+            }
+            run_operations(text, arguments);
+        }
+        catch (const std::runtime_error& e) {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            std::terminate();
+        }
+    }
     else {
         // must stop execution for file not found errors.
         std::ifstream file(arguments.at(1));
@@ -58,36 +453,22 @@ int main(int argc, char** argv){
             std::cerr << "ERROR: File `" << arguments.at(1) << "` not found." << std::endl;
             std::terminate();
         }
-        std::istream_iterator<std::string> begin{file};
-        std::istream_iterator<std::string> end;
-        std::vector<std::string> text{begin, end};
-
-        std::unordered_map<std::string, int> table{editor::create_frequency_table(text)};
-
-        std::ranges::for_each(arguments, [&](const std::string& arg) {
-        // parse the argument to get the parts
-        const std::vector<std::string> arg_parts{editor::parse_argument(arg)};
-        const std::string& flag{arg_parts.at(0)};
+        std::ostringstream content{};
+        content << file.rdbuf();
+        const std::string buffer{std::move(content).str()};
+        // the words are views of the buffer, as with `--mmap`, so it must outlive them.
+        std::vector<std::string_view> text{editor::split_words(buffer)};
+        if (normalize) {
+            normalize->apply(text);
+        }
 
-        if (flag == "--help") {
-            editor::print_help();
-        } else if (flag == "--print") {
-            editor::print_text(text);
-        } else if (flag == "--table") {
-            editor::print_table(table);
-        } else if (flag == "--frequency") {
-            editor::print_frequency(table);
-        } else if (flag == "--remove") {
-            const std::string& word{arg_parts.at(1)};
-            text = editor::remove_word(text, word);
-            table = editor::create_frequency_table(text);
-        } else if (flag == "--substitute") {
-            const std::string& old_word{arg_parts.at(1)};
-            const std::string& new_word{arg_parts.at(2)};
-            text = editor::substitute_word(text, old_word, new_word);
-            table = editor::create_frequency_table(text);
-        } else{}
-        });
+        try {
+            run_operations(text, arguments);
+        }
+        catch (const std::runtime_error& e) {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            std::terminate();
+        }
     }
 
     return 0;
@@ -31,13 +31,23 @@
 #include <iomanip>
 #include <iterator>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <thread>
 #include "editor.hpp"
+#include "output_buffer.hpp"
 
 // ------------------- PRIVATE FUNCTIONS -------------------
 
 namespace helper{
-    // get the length of the longest string in list of pairs of <strings, int>
-    int max_word_length(const std::vector<std::pair<std::string, int>>& pairs_vector){
+    using Entry = editor::FrequencyTable::value_type;
+
+    // get the length of the longest word in a list of (word, frequency) pairs
+    template<typename Pair>
+    int longest_word(const std::vector<Pair>& pairs_vector){
         const auto it{std::ranges::max_element(pairs_vector, [](const auto& a, const auto& b){
             return a.first.length() < b.first.length();
         })};
@@ -50,22 +60,239 @@ namespace helper{
 
         return max_length;
     }
+
+    // get the length of the longest string in list of pairs of <strings, int>
+    int max_word_length(const std::vector<std::pair<std::string, int>>& pairs_vector){
+        return longest_word(pairs_vector);
+    }
+
+    // get the length of the longest word in list of table entries
+    int max_word_length(const std::vector<Entry>& entries){
+        return longest_word(entries);
+    }
+
+    // order of words by descending frequency, then by descending word for equal frequencies.
+    template<typename Pair>
+    bool more_frequent(const Pair& pair1, const Pair& pair2){
+        return pair1.second != pair2.second ? pair1.second > pair2.second : pair1.first > pair2.first;
+    }
+
+    // print (word, frequency) pairs with the words right-aligned.
+    template<typename Pair>
+    void print_pairs(const std::vector<Pair>& pairs_vector, std::ostream& os){
+        const std::size_t max_length{static_cast<std::size_t>(max_word_length(pairs_vector))};
+        editor::OutputBuffer output{os};
+
+        std::ranges::for_each(pairs_vector, [&output, max_length](const auto& pair){
+            output.pad(max_length - pair.first.length());
+            output.write(pair.first);
+            output.write(' ');
+            output.write(pair.second);
+            output.write('\n');
+        });
+    }
+
+    // print words, each followed by a space, and end the line.
+    template<typename Word>
+    void print_words(const std::vector<Word>& text_vector, std::ostream& os){
+        {
+            editor::OutputBuffer output{os};
+            std::ranges::for_each(text_vector, [&output](const Word& word){
+                output.write(word);
+                output.write(' ');
+            });
+        }
+        os << std::endl;
+    }
+
+    // smallest number of words for which counting is automatically split over several threads.
+    constexpr std::size_t min_parallel_words{1 << 16};
+
+    // smallest number of words counted by each thread.
+    constexpr std::size_t min_words_per_thread{1 << 10};
+
+    // number of threads to work on a number of items with, where zero chooses it from the number of items.
+    std::size_t thread_count(const std::size_t num_items, unsigned num_threads){
+        if(num_threads == 0){
+            num_threads = num_items < min_parallel_words ? 1 : std::thread::hardware_concurrency();
+        }
+        return std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(num_items / min_words_per_thread, 1));
+    }
+
+    /**
+     * @brief Sort on several threads.
+     *
+     * Every thread sorts one run of the items, then the runs are merged pairwise,
+     * with all merges of a round on their own threads.
+     */
+    template<typename Item, typename Compare>
+    void parallel_sort(std::span<Item> items, Compare compare, const unsigned num_threads){
+        const std::size_t num_runs{thread_count(items.size(), num_threads)};
+
+        if(num_runs == 1){
+            std::ranges::sort(items, compare);
+            return;
+        }
+
+        Item* const data{items.data()};
+        std::vector<std::size_t> bounds(num_runs + 1);
+        for(std::size_t i{0}; i <= num_runs; i++){
+            bounds[i] = items.size() * i / num_runs;
+        }
+
+        {
+            std::vector<std::jthread> threads{};
+            for(std::size_t i{0}; i < num_runs; i++){
+                threads.emplace_back([data, &bounds, &compare, i]{
+                    std::sort(data + bounds[i], data + bounds[i + 1], compare);
+                });
+            }
+        }
+
+        for(std::size_t width{1}; width < num_runs; width *= 2){
+            std::vector<std::jthread> threads{};
+            for(std::size_t i{0}; i + width < num_runs; i += 2 * width){
+                const std::size_t begin{bounds[i]};
+                const std::size_t middle{bounds[i + width]};
+                const std::size_t end{bounds[std::min(i + 2 * width, num_runs)]};
+                threads.emplace_back([data, &compare, begin, middle, end]{
+                    std::inplace_merge(data + begin, data + middle, data + end, compare);
+                });
+            }
+        }
+    }
+
+    /**
+     * @brief Sort table entries by descending frequency, then by descending word.
+     *
+     * Frequencies are small non-negative integers, so the entries are first ordered by
+     * frequency with a stable radix sort, one pass per byte of the difference between the
+     * largest and smallest frequency. Only the entries of each group of equal frequency
+     * are then compared by word.
+     */
+    void sort_by_frequency(std::vector<Entry>& entries, const unsigned num_threads){
+        const auto [min_entry, max_entry]{std::ranges::minmax_element(entries, {}, &Entry::second)};
+        const auto max_count{static_cast<std::uint32_t>(entries.empty() ? 0 : max_entry->second)};
+        const auto range{static_cast<std::uint32_t>(entries.empty() ? 0 : max_entry->second - min_entry->second)};
+
+        // descending frequency is ascending distance to the largest frequency.
+        std::vector<Entry> buffer(entries.size());
+        for(unsigned shift{0}; shift < std::bit_width(range); shift += 8){
+            std::array<std::size_t, 257> offsets{};
+            const auto digit{[max_count, shift](const Entry& entry){
+                return (max_count - static_cast<std::uint32_t>(entry.second)) >> shift & 0xFF;
+            }};
+
+            std::ranges::for_each(entries, [&](const Entry& entry){offsets[digit(entry) + 1]++;});
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            std::ranges::for_each(entries, [&](const Entry& entry){buffer[offsets[digit(entry)]++] = entry;});
+            entries.swap(buffer);
+        }
+
+        for(auto group_begin{entries.begin()}; group_begin != entries.end();){
+            const auto group_end{std::find_if(group_begin, entries.end(), [&group_begin](const Entry& entry){
+                return entry.second != group_begin->second;
+            })};
+            parallel_sort(std::span<Entry>{group_begin, group_end}, [](const Entry& a, const Entry& b){
+                return a.first > b.first;
+            }, num_threads);
+            group_begin = group_end;
+        }
+    }
+
+    // count words into one table per shard, where the shard of a word is given by its hash.
+    template<typename Word>
+    std::vector<editor::FrequencyTable> count_sharded(std::span<const Word> words, const std::size_t num_shards){
+        std::vector<editor::FrequencyTable> shards(num_shards);
+        const std::hash<std::string_view> hash{};
+
+        std::ranges::for_each(words, [&](const Word& word){
+            shards[hash(word) % num_shards].add(word);
+        });
+
+        return shards;
+    }
+
+    /**
+     * @brief Count words on several threads.
+     *
+     * The text is split into one chunk of words per thread, and each thread counts its chunk
+     * into its own tables, one per shard. Then each thread merges one shard of all threads,
+     * taking over the interned words instead of copying them, and finally the shards are joined.
+     * With zero threads, several threads are only used for large texts, and each thread
+     * counts at least a minimum number of words.
+     */
+    template<typename Word>
+    editor::FrequencyTable count_words(const std::vector<Word>& text_vector, unsigned num_threads){
+        num_threads = thread_count(text_vector.size(), num_threads);
+
+        if(num_threads == 1){
+            editor::FrequencyTable table{};
+            std::ranges::for_each(text_vector, [&table](const Word& word){table.add(word);});
+            return table;
+        }
+
+        const std::span<const Word> words{text_vector};
+        std::vector<std::vector<editor::FrequencyTable>> shards(num_threads);
+        {
+            std::vector<std::jthread> threads{};
+            for(std::size_t t{0}; t < num_threads; t++){
+                const std::size_t begin{words.size() * t / num_threads};
+                const std::size_t end{words.size() * (t + 1) / num_threads};
+                threads.emplace_back([&shards, words, t, begin, end, num_threads]{
+                    shards[t] = count_sharded(words.subspan(begin, end - begin), num_threads);
+                });
+            }
+        }
+        {
+            std::vector<std::jthread> threads{};
+            for(std::size_t s{0}; s < num_threads; s++){
+                threads.emplace_back([&shards, s]{
+                    for(std::size_t t{1}; t < shards.size(); t++){
+                        shards[0][s].merge(std::move(shards[t][s]));
+                    }
+                });
+            }
+        }
+
+        editor::FrequencyTable table{std::move(shards[0][0])};
+        for(std::size_t s{1}; s < num_threads; s++){
+            table.merge(std::move(shards[0][s]));
+        }
+
+        return table;
+    }
 }
 
 // ------------------- PUBLIC FUNCTIONS -------------------
 
 namespace editor {
     /**
-     * @brief Create and return an unordered frequency dictionary of all words in a vector.
+     * @brief Create and return a frequency table of all words in a vector.
+     *
+     * Large vectors are counted on several threads.
      *
      * @param text_vector: constant reference to a vector of words.
+     * @param num_threads: number of threads to count on, by default chosen from the size of the vector.
      * @return table: a table of `word`:`frequency` pairs.
      */
-    std::unordered_map<std::string, int> create_frequency_table(const std::vector<std::string>& text_vector){
-        std::unordered_map<std::string, int> table{};
-        std::ranges::for_each(text_vector, [&table](const std::string& word){table[word]++;});
+    FrequencyTable create_frequency_table(const std::vector<std::string>& text_vector,
+                                          const unsigned num_threads){
+        return helper::count_words(text_vector, num_threads);
+    }
 
-        return table;
+    /**
+     * @brief Create and return a frequency table of all words in a vector of views.
+     *
+     * Large vectors are counted on several threads.
+     *
+     * @param text_vector: constant reference to a vector of views of words.
+     * @param num_threads: number of threads to count on, by default chosen from the size of the vector.
+     * @return table: a table of `word`:`frequency` pairs.
+     */
+    FrequencyTable create_frequency_table(const std::vector<std::string_view>& text_vector,
+                                          const unsigned num_threads){
+        return helper::count_words(text_vector, num_threads);
     }
 
     /**
@@ -74,25 +301,90 @@ namespace editor {
      * @param table: A table of words as keys and their frequencies as value.
      * @return a vector of (word, frequency) pairs, sorted by word.
      */
-    std::vector<std::pair<std::string, int>> sort_table_by_keys(const std::unordered_map<std::string, int>& table){
-        std::vector<std::pair<std::string, int>> key_sorted_vector(table.begin(), table.end());
-        std::ranges::sort(key_sorted_vector);
-        return key_sorted_vector;
+    std::vector<std::pair<std::string, int>> sort_table_by_keys(const FrequencyTable& table){
+        const std::vector<FrequencyTable::value_type> entries{sort_entries_by_keys(table)};
+        return {entries.begin(), entries.end()};
+    }
+
+    /**
+     * @brief Create and return the entries of a table, sorted by word.
+     *
+     * Only views of the words are sorted, not copies. Large tables are sorted on several threads.
+     *
+     * @param table: A table of words as keys and their frequencies as value.
+     * @param num_threads: number of threads to sort on, by default chosen from the size of the table.
+     * @return a vector of (word, frequency) entries of the table, sorted by word.
+     */
+    std::vector<FrequencyTable::value_type> sort_entries_by_keys(const FrequencyTable& table,
+                                                                 const unsigned num_threads){
+        std::vector<FrequencyTable::value_type> entries(table.begin(), table.end());
+        helper::parallel_sort(std::span{entries}, std::ranges::less{}, num_threads);
+        return entries;
     }
 
     /**
      * @brief Create and return a sorted vector of pairs, sorted by second element.
      *
+     * Words with the same frequency are sorted in descending order too.
+     *
      * @param table: A table of words as keys and their frequencies as value.
      * @return a vector of (word, frequency) pairs, sorted by frequency.
      */
-    std::vector<std::pair<std::string, int>> sort_table_by_values(const std::unordered_map<std::string, int>& table){
-        std::vector<std::pair<std::string, int>> value_sorted_vector(table.begin(), table.end());
-        std::ranges::sort(value_sorted_vector, [](const auto& pair1, const auto& pair2){
-            return pair1.second > pair2.second;
-        });
+    std::vector<std::pair<std::string, int>> sort_table_by_values(const FrequencyTable& table){
+        const std::vector<FrequencyTable::value_type> entries{sort_entries_by_values(table)};
+        return {entries.begin(), entries.end()};
+    }
+
+    /**
+     * @brief Create and return the entries of a table, sorted by frequency.
+     *
+     * Sorted the same way as `sort_table_by_values`, but only views of the words are
+     * sorted, with a radix sort on the frequencies. Large groups of words with the same
+     * frequency are sorted on several threads.
+     *
+     * @param table: A table of words as keys and their frequencies as value.
+     * @param num_threads: number of threads to sort on, by default chosen from the size of the table.
+     * @return a vector of (word, frequency) entries of the table, sorted by frequency.
+     */
+    std::vector<FrequencyTable::value_type> sort_entries_by_values(const FrequencyTable& table,
+                                                                   const unsigned num_threads){
+        std::vector<FrequencyTable::value_type> entries(table.begin(), table.end());
+        helper::sort_by_frequency(entries, num_threads);
+        return entries;
+    }
 
-        return value_sorted_vector;
+    /**
+     * @brief Create and return the most frequent words of a table, sorted by frequency.
+     *
+     * Only a heap of the k most frequent entries seen so far is kept while going over
+     * the table once, so only the returned words are copied and nothing else is sorted.
+     * The order is the same as for `sort_table_by_values`.
+     *
+     * @param table: A table of words as keys and their frequencies as value.
+     * @param k: the number of words to return, at most.
+     * @return a vector of the k most frequent (word, frequency) pairs, sorted by frequency.
+     */
+    std::vector<std::pair<std::string, int>> top_words(const FrequencyTable& table, const std::size_t k){
+        const auto comparator{helper::more_frequent<FrequencyTable::value_type>};
+        std::vector<FrequencyTable::value_type> heap{};
+        heap.reserve(std::min(k, table.size()));
+
+        // the least frequent of the kept entries is at the front of the heap.
+        for(const FrequencyTable::value_type& entry : table){
+            if(heap.size() < k){
+                heap.push_back(entry);
+                std::ranges::push_heap(heap, comparator);
+            }
+            else if(k > 0 && comparator(entry, heap.front())){
+                std::ranges::pop_heap(heap, comparator);
+                heap.back() = entry;
+                std::ranges::push_heap(heap, comparator);
+            }
+        }
+
+        std::ranges::sort_heap(heap, comparator);
+
+        return {heap.begin(), heap.end()};
     }
 
     /**
@@ -102,8 +394,17 @@ namespace editor {
      * @param os: an output stream, by default std::cout is used.
      */
     void print_text(const std::vector<std::string>& text_vector, std::ostream& os){
-        std::ranges::copy(text_vector, std::ostream_iterator<std::string>{os, " "});
-        os << std::endl;
+        helper::print_words(text_vector, os);
+    }
+
+    /**
+     * @brief Print all words in a vector of views, separated by space.
+     *
+     * @param text_vector: constant reference to a vector of views of words.
+     * @param os: an output stream, by default std::cout is used.
+     */
+    void print_text(const std::vector<std::string_view>& text_vector, std::ostream& os){
+        helper::print_words(text_vector, os);
     }
 
     /**
@@ -112,15 +413,19 @@ namespace editor {
      * First the table is sorted, then printed. The keys are left-aligned
      * and sorted in descending order.
      *
-     * @param table: an unordered map of words and their frequencies.
+     * @param table: a table of words and their frequencies.
      * @param os: an output stream, by default std::cout is used.
      */
-    void print_table(const std::unordered_map<std::string, int>& table, std::ostream& os){
-        std::vector<std::pair<std::string, int>> sorted_vector{sort_table_by_keys(table)};
-        int max_length{helper::max_word_length(sorted_vector)};
-
-        std::ranges::for_each(sorted_vector, [&os, &max_length](const auto& pair)
-        {os << std::left << std::setw(max_length + 1) << pair.first << pair.second << "\n";
+    void print_table(const FrequencyTable& table, std::ostream& os){
+        const std::vector<FrequencyTable::value_type> sorted_vector{sort_entries_by_keys(table)};
+        const std::size_t max_length{static_cast<std::size_t>(helper::max_word_length(sorted_vector))};
+        OutputBuffer output{os};
+
+        std::ranges::for_each(sorted_vector, [&output, max_length](const auto& pair){
+            output.write(pair.first);
+            output.pad(max_length + 1 - pair.first.length());
+            output.write(pair.second);
+            output.write('\n');
         });
     }
 
@@ -130,16 +435,48 @@ namespace editor {
      * First the table is sorted, then printed. The keys are right-aligned
      * and sorted in descending order.
      *
-     * @param table: an unordered map of words and their frequencies.
+     * @param table: a table of words and their frequencies.
      * @param os: an output stream, by default std::cout is used.
      */
-    void print_frequency(const std::unordered_map<std::string, int>& table, std::ostream& os){
-        std::vector<std::pair<std::string, int>> sorted_vector{sort_table_by_values(table)};
-        int max_length{helper::max_word_length(sorted_vector)};
+    void print_frequency(const FrequencyTable& table, std::ostream& os){
+        helper::print_pairs(sort_entries_by_values(table), os);
+    }
 
-        std::ranges::for_each(sorted_vector, [&os, &max_length](const auto& pair)
-        {os << std::right << std::setw(max_length) << pair.first << " " << pair.second << "\n";
+    /**
+     * @brief Print the most frequent words of a frequency table.
+     *
+     * Printed in the same format as `print_frequency`, but only the first k words.
+     *
+     * @param table: a table of words and their frequencies.
+     * @param k: the number of words to print, at most.
+     * @param os: an output stream, by default std::cout is used.
+     */
+    void print_top(const FrequencyTable& table, const std::size_t k, std::ostream& os){
+        helper::print_pairs(top_words(table, k), os);
+    }
+
+    /**
+     * @brief Print the positions of a word in a text.
+     *
+     * The word and its frequency are followed by the positions, on one line.
+     *
+     * @param word: the word.
+     * @param positions: the numbers of the words of the text that are equal to it.
+     * @param os: an output stream, by default std::cout is used.
+     */
+    void print_positions(const std::string_view word, const std::vector<std::uint64_t>& positions,
+                         std::ostream& os){
+        OutputBuffer output{os};
+        output.write(word);
+        output.write(' ');
+        output.write(static_cast<std::uint64_t>(positions.size()));
+        output.write(':');
+
+        std::ranges::for_each(positions, [&output](const std::uint64_t position){
+            output.write(' ');
+            output.write(position);
         });
+        output.write('\n');
     }
 
     /**
@@ -151,31 +488,77 @@ namespace editor {
     void print_help(){
         std::cout << "\nDescription: \n";
         std::cout << "  This program can be used to edit text files through the command-line.\n\n";
-        const std::string longest_string{"--substitute=<old>+<new>"};
+        const std::string longest_string{"--substitute-regex=<re>+<new>"};
         const int len{static_cast<int>(longest_string.length()) + 4};
 
         std::cout << "Usage: \n";
-        std::cout << "  <a.out> <path/to/text_file> [--help] [--print] [--table] [--frequency] [--remove=<word>] "
-                     "[--substitute=<old>+<new>]\n\n";
+        std::cout << "  <a.out> <path/to/text_file> [--help]\n"
+                     "          [--mmap] [--stream=<file>] [--corpus=<dir>] [--index]\n"
+                     "          [--print] [--table] [--frequency] [--top=<k>]\n"
+                     "          [--remove=<word>] [--substitute=<old>+<new>] [--substitute-file=<rules>]\n"
+                     "          [--remove-regex=<re>] [--substitute-regex=<re>+<new>]\n"
+                     "          [--build-index=<file>] [--positions=<word>]\n"
+                     "          [--ngrams=<n>[+<k>]] [--normalize]\n\n";
         std::cout << "Required Arguments: \n";
         std::cout << "  <a.out>" << std::setw(5) << "An executable file.\n";
         std::cout << "  <path/to/text_file>" << std::setw(5) << "Path to a text file.\n\n";
 
         std::cout << "Optional Arguments: \n";
         std::cout << std::left << std::setw(len) << "  --help" << "Print this message.\n";
+        std::cout << std::left << std::setw(len) << "  --mmap" << "Memory-map the text file instead of reading "
+                                                                  "it into memory, for very large files.\n";
+        std::cout << std::left << std::setw(len) << "  --stream=<file>" << "Read the text file in chunks and print "
+                                                                           "the text to <file>, for files larger "
+                                                                           "than memory.\n";
+        std::cout << std::left << std::setw(len) << "  --corpus=<dir>" << "The path is a directory or a pattern such "
+                                                                          "as `texts/*.txt`, whose files are processed "
+                                                                          "in parallel, printing each to <dir>.\n";
+        std::cout << std::left << std::setw(len) << "  --index" << "The text file is an index written by "
+                                                                   "--build-index, answer from it without the text.\n";
         std::cout << std::left << std::setw(len) << "  --print" << "Print the content of the provided text file.\n";
         std::cout << std::left << std::setw(len) << "  --table" << "Print the frequency of the words sorted by the "
                                                                    "words.\n";
         std::cout << std::left << std::setw(len) << "  --frequency" << "Print the frequency of the words sorted by the "
                                                                        "frequencies.\n";
+        std::cout << std::left << std::setw(len) << "  --top=<k>" << "Print only the <k> most frequent words, "
+                                                                     "like --frequency.\n";
         std::cout << std::left << std::setw(len) << "  --remove=<word>" << "Remove all occurrences of <word>.\n";
         std::cout << std::left << std::setw(len) << "  --substitute=<old>+<new>" << "Substitutes all occurrences of "
-                                                                                    "<old> with <new>.\n\n";
+                                                                                    "<old> with <new>.\n";
+        std::cout << std::left << std::setw(len) << "  --substitute-file=<rules>" << "Substitutes the words of all "
+                                                                                     "`<old> <new>` lines of the "
+                                                                                     "<rules> file at once.\n";
+        std::cout << std::left << std::setw(len) << "  --remove-regex=<re>" << "Remove all words that match the "
+                                                                               "regular expression <re>.\n";
+        std::cout << std::left << std::setw(len) << "  --substitute-regex=<re>+<new>" << "Substitutes all words that "
+                                                                                         "match <re> with <new>, which "
+                                                                                         "follows the last `+`.\n";
+        std::cout << std::left << std::setw(len) << "  --build-index=<file>" << "Write an index of the words of the "
+                                                                                "text to <file>.\n";
+        std::cout << std::left << std::setw(len) << "  --positions=<word>" << "Print the positions of <word> in the "
+                                                                              "indexed text.\n";
+        std::cout << std::left << std::setw(len) << "  --ngrams=<n>[+<k>]" << "Print the frequency of the "
+                                                                              "sequences of <n> words, from 1 to 4, "
+                                                                              "like --frequency, or only the <k> "
+                                                                              "most frequent.\n";
+        std::cout << std::left << std::setw(len) << "  --normalize" << "Fold the case of all words and strip the "
+                                                                       "punctuation around them, before any other "
+                                                                       "operation.\n\n";
 
         std::cout << "Example Usages: \n";
         std::cout << "  ./a.out text_file.txt --print\n";
         std::cout << "  ./a.out text_file.txt --remove=word --table\n";
-        std::cout << "  ./a.out text_file.txt --substitute=word+WORD --frequency\n\n";
+        std::cout << "  ./a.out text_file.txt --substitute=word+WORD --frequency\n";
+        std::cout << "  ./a.out text_file.txt --mmap --table\n";
+        std::cout << "  ./a.out text_file.txt --mmap --top=100\n";
+        std::cout << "  ./a.out text_file.txt --normalize --frequency\n";
+        std::cout << "  ./a.out text_file.txt --mmap --ngrams=2+20\n";
+        std::cout << "  ./a.out text_file.txt --substitute-file=rules.txt --print\n";
+        std::cout << "  ./a.out text_file.txt --remove-regex='un.*' --substitute-regex='[0-9]++NUMBER' --print\n";
+        std::cout << "  ./a.out text_file.txt --mmap --build-index=text.idx\n";
+        std::cout << "  ./a.out text.idx --index --positions=word --substitute=word+WORD --top=10\n";
+        std::cout << "  ./a.out text_file.txt --stream=edited.txt --remove=word --print --frequency\n";
+        std::cout << "  ./a.out 'texts/*.txt' --corpus=edited --remove=word --print --top=10\n\n";
     }
 
     /**
@@ -220,10 +603,16 @@ namespace editor {
 
         pair1 = split_string(arg, '=');
 
-        if(pair1.first == "--substitute"){
+        if(pair1.first == "--substitute" || pair1.first == "--ngrams"){
             pair2 = split_string(pair1.second, '+');
             parts = {pair1.first, pair2.first, pair2.second};
         }
+        else if(pair1.first == "--substitute-regex"){
+            // the pattern may contain `+` itself, so the new word follows the last one.
+            const std::size_t pos{pair1.second.rfind('+')};
+            parts = {pair1.first, pair1.second.substr(0, pos),
+                     pos == std::string::npos ? "" : pair1.second.substr(pos + 1)};
+        }
         else{
             parts = {pair1.first, pair1.second, ""};
         }
@@ -240,18 +629,42 @@ namespace editor {
     bool is_argument_valid(const std::string& arg){
         bool is_valid{false};
 
-        if(arg == "--help" || arg == "--print" || arg == "--table" || arg == "--frequency" || arg == "--help"){
+        if(arg == "--help" || arg == "--print" || arg == "--table" || arg == "--frequency" || arg == "--mmap" ||
+           arg == "--index" || arg == "--normalize"){
             is_valid = true;
         }
 
         const std::vector<std::string> parts{parse_argument(arg)};
 
-        if (parts.at(0) == "--remove"){
+        if (parts.at(0) == "--remove" || parts.at(0) == "--remove-regex"){
             is_valid = (parts.at(0) + "=" + parts.at(1) == arg) &&
                        (!parts.at(1).empty()) && (parts.at(2).empty());
         }
 
-        if (parts.at(0) == "--substitute"){
+        if (parts.at(0) == "--stream" || parts.at(0) == "--corpus" || parts.at(0) == "--substitute-file" ||
+            parts.at(0) == "--build-index" || parts.at(0) == "--positions"){
+            is_valid = (parts.at(0) + "=" + parts.at(1) == arg) && (!parts.at(1).empty());
+        }
+
+        if (parts.at(0) == "--top"){
+            is_valid = (parts.at(0) + "=" + parts.at(1) == arg) && (!parts.at(1).empty()) &&
+                       (parts.at(1).size() <= 9) && std::ranges::all_of(parts.at(1), [](const char c){
+                           return c >= '0' && c <= '9';
+                       });
+        }
+
+        if (parts.at(0) == "--ngrams"){
+            const auto is_number{[](const std::string& part){
+                return !part.empty() && part.size() <= 9 && std::ranges::all_of(part, [](const char c){
+                    return c >= '0' && c <= '9';
+                });
+            }};
+            is_valid = (parts.at(0) + "=" + parts.at(1) + (parts.at(2).empty() ? "" : "+" + parts.at(2)) == arg) &&
+                       (parts.at(1).size() == 1) && (parts.at(1) >= "1") && (parts.at(1) <= "4") &&
+                       (parts.at(2).empty() || is_number(parts.at(2)));
+        }
+
+        if (parts.at(0) == "--substitute" || parts.at(0) == "--substitute-regex"){
             is_valid = (parts.at(0) + "=" + parts.at(1) + "+" + parts.at(2) == arg) &&
                                                        (!parts.at(1).empty()) &&
                                                        (!parts.at(2).empty());
@@ -299,5 +712,110 @@ namespace editor {
 
         return new_text;
     }
+
+    /**
+     * @brief Remove all occurrences of a word in a list of views of words.
+     *
+     * A new vector is created and returned, leaving the original one unmodified.
+     * Only the views are copied, not the words they refer to.
+     *
+     * @param text: A vector of views of words.
+     * @param word: The word to be removed.
+     * @return new vector of views of words.
+     */
+    std::vector<std::string_view> remove_word(const std::vector<std::string_view>& text, const std::string_view word){
+        std::vector<std::string_view> new_text{};
+        new_text.reserve(text.size());
+        std::ranges::remove_copy(text, std::back_inserter(new_text), word);
+
+        return new_text;
+    }
+
+    /**
+     * @brief Substitutes all occurrences of a word with another word in a list of views of words.
+     *
+     * A new vector is created and returned, leaving the original one unmodified.
+     * The new word is not copied, so it must outlive the returned vector.
+     *
+     * @param text: A vector of views of words.
+     * @param old_word: The word to be replaced.
+     * @param new_word: The word to replace old word with.
+     * @return new vector of views of words.
+     */
+    std::vector<std::string_view> substitute_word(const std::vector<std::string_view>& text,
+                                                  const std::string_view old_word,
+                                                  const std::string_view new_word){
+        std::vector<std::string_view> new_text(text.size());
+        std::ranges::replace_copy(text, new_text.begin(), old_word, new_word);
+
+        return new_text;
+    }
+
+    /**
+     * @brief Remove all occurrences of a word in a list of words, in place.
+     *
+     * The given vector is edited and moved into the returned one, so no words are
+     * copied and no memory is allocated.
+     *
+     * @param text: A vector of words, which is moved from.
+     * @param word: The string word to be removed.
+     * @return the edited vector of words.
+     */
+    std::vector<std::string> remove_word(std::vector<std::string>&& text, const std::string& word){
+        const auto removed{std::ranges::remove(text, word)};
+        text.erase(removed.begin(), removed.end());
+
+        return std::move(text);
+    }
+
+    /**
+     * @brief Substitutes all occurrences of a word with another word, in place.
+     *
+     * The given vector is edited and moved into the returned one, so only the
+     * substituted words are assigned.
+     *
+     * @param text: A vector of words, which is moved from.
+     * @param old_word: The string word to be replaced.
+     * @param new_word: The string word to replace old word with.
+     * @return the edited vector of words.
+     */
+    std::vector<std::string> substitute_word(std::vector<std::string>&& text, const std::string& old_word,
+                                             const std::string& new_word){
+        std::ranges::replace(text, old_word, new_word);
+
+        return std::move(text);
+    }
+
+    /**
+     * @brief Remove all occurrences of a word in a list of views of words, in place.
+     *
+     * @param text: A vector of views of words, which is moved from.
+     * @param word: The word to be removed.
+     * @return the edited vector of views of words.
+     */
+    std::vector<std::string_view> remove_word(std::vector<std::string_view>&& text, const std::string_view word){
+        const auto removed{std::ranges::remove(text, word)};
+        text.erase(removed.begin(), removed.end());
+
+        return std::move(text);
+    }
+
+    /**
+     * @brief Substitutes all occurrences of a word with another word in a list of views of words, in place.
+     *
+     * The new word is not copied, so it must outlive the returned vector.
+     *
+     * @param text: A vector of views of words, which is moved from.
+     * @param old_word: The word to be replaced.
+     * @param new_word: The word to replace old word with.
+     * @return the edited vector of views of words.
+     */
+    std::vector<std::string_view> substitute_word(std::vector<std::string_view>&& text,
+                                                  const std::string_view old_word,
+                                                  const std::string_view new_word){
+        std::ranges::replace(text, old_word, new_word);
+
+        return std::move(text);
+    }
 }
 // ============== END OF FILE ==============
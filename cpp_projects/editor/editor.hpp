@@ -8,23 +8,41 @@
 #ifndef EDITOR_HPP
 #define EDITOR_HPP
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
+#include "frequency_table.hpp"
 
 namespace editor {
-    std::unordered_map<std::string, int> create_frequency_table(const std::vector<std::string>& text_vector);
+    FrequencyTable create_frequency_table(const std::vector<std::string>& text_vector, unsigned num_threads = 0);
 
-    std::vector<std::pair<std::string, int>> sort_table_by_keys(const std::unordered_map<std::string, int>& table);
+    FrequencyTable create_frequency_table(const std::vector<std::string_view>& text_vector, unsigned num_threads = 0);
 
-    std::vector<std::pair<std::string, int>> sort_table_by_values(const std::unordered_map<std::string, int>& table);
+    std::vector<std::pair<std::string, int>> sort_table_by_keys(const FrequencyTable& table);
+
+    std::vector<std::pair<std::string, int>> sort_table_by_values(const FrequencyTable& table);
+
+    std::vector<FrequencyTable::value_type> sort_entries_by_keys(const FrequencyTable& table, unsigned num_threads = 0);
+
+    std::vector<FrequencyTable::value_type> sort_entries_by_values(const FrequencyTable& table,
+                                                                   unsigned num_threads = 0);
+
+    std::vector<std::pair<std::string, int>> top_words(const FrequencyTable& table, std::size_t k);
 
     void print_text(const std::vector<std::string>& text_vector, std::ostream& os = std::cout);
 
-    void print_table(const std::unordered_map<std::string, int>& table, std::ostream& os = std::cout);
+    void print_text(const std::vector<std::string_view>& text_vector, std::ostream& os = std::cout);
 
-    void print_frequency(const std::unordered_map<std::string, int>& table, std::ostream& os = std::cout);
+    void print_table(const FrequencyTable& table, std::ostream& os = std::cout);
+
+    void print_frequency(const FrequencyTable& table, std::ostream& os = std::cout);
+
+    void print_top(const FrequencyTable& table, std::size_t k, std::ostream& os = std::cout);
+
+    void print_positions(std::string_view word, const std::vector<std::uint64_t>& positions,
+                         std::ostream& os = std::cout);
 
     void print_help();
 
@@ -39,10 +57,27 @@ namespace editor {
     std::vector<std::string> substitute_word(const std::vector<std::string>& text, const std::string& old_word,
                                              const std::string& new_word);
 
+    std::vector<std::string_view> remove_word(const std::vector<std::string_view>& text, std::string_view word);
+
+    std::vector<std::string_view> substitute_word(const std::vector<std::string_view>& text,
+                                                  std::string_view old_word, std::string_view new_word);
+
+    std::vector<std::string> remove_word(std::vector<std::string>&& text, const std::string& word);
+
+    std::vector<std::string> substitute_word(std::vector<std::string>&& text, const std::string& old_word,
+                                             const std::string& new_word);
+
+    std::vector<std::string_view> remove_word(std::vector<std::string_view>&& text, std::string_view word);
+
+    std::vector<std::string_view> substitute_word(std::vector<std::string_view>&& text, std::string_view old_word,
+                                                  std::string_view new_word);
+
 }
 
 namespace helper {
     int max_word_length(const std::vector<std::pair<std::string, int>>& pairs_vector);
+
+    int max_word_length(const std::vector<editor::FrequencyTable::value_type>& entries);
 }
 
 #endif // EDITOR_HPP
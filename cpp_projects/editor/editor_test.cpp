@@ -30,41 +30,60 @@ TEST_CASE("Test print_text() function"){
 TEST_CASE("Test editor::create_frequency_table() function"){
     // empty vector
     std::vector<std::string> empty_text{};
-    std::unordered_map<std::string, int> empty_text_frequency{editor::create_frequency_table(empty_text)};
+    editor::FrequencyTable empty_text_frequency{editor::create_frequency_table(empty_text)};
     REQUIRE(empty_text_frequency.size() == 0);
 
     // onve-word vector
     std::vector<std::string> one_word_text{"one_word"};
-    std::unordered_map<std::string, int> one_word_text_frequency{editor::create_frequency_table(one_word_text)};
+    editor::FrequencyTable one_word_text_frequency{editor::create_frequency_table(one_word_text)};
     REQUIRE(one_word_text_frequency.size() == 1);
     REQUIRE(one_word_text_frequency.at("one_word") == 1);
 
     // three unique words vector
     std::vector<std::string> three_words_text{"first", "second", "third"};
-    std::unordered_map<std::string, int> three_words_text_frequency{editor::create_frequency_table(three_words_text)};
+    editor::FrequencyTable three_words_text_frequency{editor::create_frequency_table(three_words_text)};
     REQUIRE(three_words_text_frequency.size() == 3);
     REQUIRE(three_words_text_frequency.at("first") == 1);
     REQUIRE(three_words_text_frequency.at("third") == 1);
 
     // repeating words vector
     std::vector<std::string> five_words_text{"first","third", "second", "first", "third"};
-    std::unordered_map<std::string, int> five_words_text_frequency{editor::create_frequency_table(five_words_text)};
+    editor::FrequencyTable five_words_text_frequency{editor::create_frequency_table(five_words_text)};
     REQUIRE(five_words_text_frequency.size() == 3);
     REQUIRE(five_words_text_frequency.at("first") == 2);
     REQUIRE(five_words_text_frequency.at("third") == 2);
     REQUIRE(five_words_text_frequency.at("second") == 1);
 }
 
+TEST_CASE("Test editor::create_frequency_table() function on several threads"){
+    // repeating words, with more threads than words too
+    std::vector<std::string> text{};
+    for(int i{0}; i < 10000; i++){
+        text.push_back("w" + std::to_string(i % 97) + (i % 5 == 0 ? "_rare" + std::to_string(i) : ""));
+    }
+    const std::vector<std::string_view> views(text.begin(), text.end());
+    const editor::FrequencyTable expected{editor::create_frequency_table(text, 1)};
+
+    for(const unsigned num_threads : {2u, 3u, 8u, 20000u}){
+        REQUIRE(editor::create_frequency_table(text, num_threads) == expected);
+        REQUIRE(editor::create_frequency_table(views, num_threads) == expected);
+    }
+
+    // empty vector
+    std::vector<std::string> empty_text{};
+    REQUIRE(editor::create_frequency_table(empty_text, 4).size() == 0);
+}
+
 TEST_CASE("Test editor::sort_table_by_keys() function"){
     // empty vector
     std::vector<std::string> empty_text{};
-    std::unordered_map<std::string, int> empty_text_frequency{editor::create_frequency_table(empty_text)};
+    editor::FrequencyTable empty_text_frequency{editor::create_frequency_table(empty_text)};
     std::vector<std::pair<std::string, int>> sorted_vector{editor::sort_table_by_keys(empty_text_frequency)};
     REQUIRE(sorted_vector.size() == 0);
 
     // onve-word vector
     std::vector<std::string> one_word_text{"one_word"};
-    std::unordered_map<std::string, int> one_word_text_frequency{editor::create_frequency_table(one_word_text)};
+    editor::FrequencyTable one_word_text_frequency{editor::create_frequency_table(one_word_text)};
     std::vector<std::pair<std::string, int>> sorted_vector1{editor::sort_table_by_keys(one_word_text_frequency)};
     REQUIRE(sorted_vector1.size() == 1);
     REQUIRE(sorted_vector1.at(0).first == "one_word");
@@ -74,7 +93,7 @@ TEST_CASE("Test editor::sort_table_by_keys() function"){
 
     // // three unique words vector
     std::vector<std::string> three_words_text{"first", "second", "third"};
-    std::unordered_map<std::string, int> three_words_text_frequency{editor::create_frequency_table(three_words_text)};
+    editor::FrequencyTable three_words_text_frequency{editor::create_frequency_table(three_words_text)};
     std::vector<std::pair<std::string, int>> sorted_vector3{editor::sort_table_by_keys(three_words_text_frequency)};
     REQUIRE(sorted_vector3.size() == 3);
     REQUIRE(sorted_vector3.at(0).first == "first");
@@ -82,7 +101,7 @@ TEST_CASE("Test editor::sort_table_by_keys() function"){
 
     // // repeating words vector
     std::vector<std::string> five_words_text{"first","third", "second", "first", "third"};
-    std::unordered_map<std::string, int> five_words_text_frequency{editor::create_frequency_table(five_words_text)};
+    editor::FrequencyTable five_words_text_frequency{editor::create_frequency_table(five_words_text)};
     std::vector<std::pair<std::string, int>> sorted_vector5{editor::sort_table_by_keys(five_words_text_frequency)};
     REQUIRE(sorted_vector5.size() == 3);
     REQUIRE(sorted_vector5.at(0).first == "first");
@@ -96,13 +115,13 @@ TEST_CASE("Test editor::sort_table_by_keys() function"){
 TEST_CASE("Test editor::sort_table_by_values() function"){
     // empty vector
     std::vector<std::string> empty_text{};
-    std::unordered_map<std::string, int> empty_text_frequency{editor::create_frequency_table(empty_text)};
+    editor::FrequencyTable empty_text_frequency{editor::create_frequency_table(empty_text)};
     std::vector<std::pair<std::string, int>> sorted_vector{editor::sort_table_by_values(empty_text_frequency)};
     REQUIRE(sorted_vector.size() == 0);
 
     // onve-word vector
     std::vector<std::string> one_word_text{"one_word"};
-    std::unordered_map<std::string, int> one_word_text_frequency{editor::create_frequency_table(one_word_text)};
+    editor::FrequencyTable one_word_text_frequency{editor::create_frequency_table(one_word_text)};
     std::vector<std::pair<std::string, int>> sorted_vector1{editor::sort_table_by_values(one_word_text_frequency)};
     REQUIRE(sorted_vector1.size() == 1);
     REQUIRE(sorted_vector1.at(0).first == "one_word");
@@ -112,7 +131,7 @@ TEST_CASE("Test editor::sort_table_by_values() function"){
 
     // // three unique words vector
     std::vector<std::string> three_words_text{"first", "second", "third"};
-    std::unordered_map<std::string, int> three_words_text_frequency{editor::create_frequency_table(three_words_text)};
+    editor::FrequencyTable three_words_text_frequency{editor::create_frequency_table(three_words_text)};
     std::vector<std::pair<std::string, int>> sorted_vector3{editor::sort_table_by_values(three_words_text_frequency)};
     REQUIRE(sorted_vector3.size() == 3);
     REQUIRE(sorted_vector3.at(0).first == "third");
@@ -120,7 +139,7 @@ TEST_CASE("Test editor::sort_table_by_values() function"){
 
     // // repeating words vector
     std::vector<std::string> five_words_text{"first","third", "second", "first", "third"};
-    std::unordered_map<std::string, int> five_words_text_frequency{editor::create_frequency_table(five_words_text)};
+    editor::FrequencyTable five_words_text_frequency{editor::create_frequency_table(five_words_text)};
     std::vector<std::pair<std::string, int>> sorted_vector5{editor::sort_table_by_values(five_words_text_frequency)};
     REQUIRE(sorted_vector5.size() == 3);
     REQUIRE(sorted_vector5.at(0).first == "third");
@@ -131,24 +150,50 @@ TEST_CASE("Test editor::sort_table_by_values() function"){
     REQUIRE(sorted_vector5.at(2).second == 1);
 }
 
+TEST_CASE("Test editor::sort_entries_by_keys() and editor::sort_entries_by_values() functions"){
+    // frequencies of several bytes, and many words with the same frequency
+    editor::FrequencyTable table{};
+    for(int i{0}; i < 30000; i++){
+        table.add("w" + std::to_string(i), i % 10 == 0 ? i * 977 % 100003 : 1 + i % 3);
+    }
+
+    const std::vector<std::pair<std::string, int>> by_keys{editor::sort_table_by_keys(table)};
+    const std::vector<std::pair<std::string, int>> by_values{editor::sort_table_by_values(table)};
+    REQUIRE(by_keys.size() == table.size());
+    REQUIRE(std::ranges::is_sorted(by_keys));
+    REQUIRE(std::ranges::is_sorted(by_values, [](const auto& a, const auto& b){
+        return a.second != b.second ? a.second > b.second : a.first > b.first;
+    }));
+
+    for(const unsigned num_threads : {1u, 2u, 3u, 8u}){
+        const auto keys{editor::sort_entries_by_keys(table, num_threads)};
+        const auto values{editor::sort_entries_by_values(table, num_threads)};
+        REQUIRE(std::vector<std::pair<std::string, int>>(keys.begin(), keys.end()) == by_keys);
+        REQUIRE(std::vector<std::pair<std::string, int>>(values.begin(), values.end()) == by_values);
+    }
+
+    // empty table
+    REQUIRE(editor::sort_entries_by_values(editor::FrequencyTable{}, 4).empty());
+}
+
 TEST_CASE("Test editor::print_table() function"){
     // empty vector
     std::vector<std::string> empty_text{};
-    std::unordered_map<std::string, int> empty_text_frequency{editor::create_frequency_table(empty_text)};
+    editor::FrequencyTable empty_text_frequency{editor::create_frequency_table(empty_text)};
     std::ostringstream oss{};
     editor::print_table(empty_text_frequency, oss);
     REQUIRE(oss.str() == "");
 
     // onve-word vector
     std::vector<std::string> one_word_text{"one_word"};
-    std::unordered_map<std::string, int> one_word_text_frequency{editor::create_frequency_table(one_word_text)};
+    editor::FrequencyTable one_word_text_frequency{editor::create_frequency_table(one_word_text)};
     std::ostringstream oss1{};
     editor::print_table(one_word_text_frequency, oss1);
     REQUIRE(oss1.str() == "one_word 1\n");
 
     // // three unique words vector
     std::vector<std::string> three_words_text{"first", "second", "third"};
-    std::unordered_map<std::string, int> three_words_text_frequency{editor::create_frequency_table(three_words_text)};
+    editor::FrequencyTable three_words_text_frequency{editor::create_frequency_table(three_words_text)};
     std::ostringstream oss3{};
     editor::print_table(three_words_text_frequency, oss3);
     REQUIRE(oss3.str() == "first  1\nsecond 1\nthird  1\n");
@@ -157,26 +202,49 @@ TEST_CASE("Test editor::print_table() function"){
 TEST_CASE("Test editor::print_frequency() function"){
     // empty vector
     std::vector<std::string> empty_text{};
-    std::unordered_map<std::string, int> empty_text_frequency{editor::create_frequency_table(empty_text)};
+    editor::FrequencyTable empty_text_frequency{editor::create_frequency_table(empty_text)};
     std::ostringstream oss{};
     editor::print_frequency(empty_text_frequency, oss);
     REQUIRE(oss.str() == "");
 
     // onve-word vector
     std::vector<std::string> one_word_text{"one_word"};
-    std::unordered_map<std::string, int> one_word_text_frequency{editor::create_frequency_table(one_word_text)};
+    editor::FrequencyTable one_word_text_frequency{editor::create_frequency_table(one_word_text)};
     std::ostringstream oss1{};
     editor::print_frequency(one_word_text_frequency, oss1);
     REQUIRE(oss1.str() == "one_word 1\n");
 
     // // three unique words vector
     std::vector<std::string> three_words_text{"first", "second", "third"};
-    std::unordered_map<std::string, int> three_words_text_frequency{editor::create_frequency_table(three_words_text)};
+    editor::FrequencyTable three_words_text_frequency{editor::create_frequency_table(three_words_text)};
     std::ostringstream oss3{};
     editor::print_frequency(three_words_text_frequency, oss3);
     REQUIRE(oss3.str() == " third 1\nsecond 1\n first 1\n");
 }
 
+TEST_CASE("Test editor::top_words() and editor::print_top() functions"){
+    std::vector<std::string> text{};
+    for(int i{0}; i < 2000; i++){
+        text.push_back("w" + std::to_string(i * i % 311));
+    }
+    editor::FrequencyTable table{editor::create_frequency_table(text)};
+
+    // the same words and order as a full sort, for any k
+    const std::vector<std::pair<std::string, int>> sorted{editor::sort_table_by_values(table)};
+    for(const std::size_t k : {0ul, 1ul, 7ul, 100ul, sorted.size(), sorted.size() + 10}){
+        const std::vector<std::pair<std::string, int>> top{editor::top_words(table, k)};
+        REQUIRE(top.size() == std::min(k, sorted.size()));
+        REQUIRE(std::equal(top.begin(), top.end(), sorted.begin()));
+    }
+
+    // printed like print_frequency
+    std::vector<std::string> five_words_text{"first","third", "second", "first", "third"};
+    editor::FrequencyTable five_words_text_frequency{editor::create_frequency_table(five_words_text)};
+    std::ostringstream oss{};
+    editor::print_top(five_words_text_frequency, 2, oss);
+    REQUIRE(oss.str() == "third 2\nfirst 2\n");
+}
+
 TEST_CASE("Test editor::split_string() function"){
     // empty string, should return two empty strings
     std::string s1{""};
@@ -274,6 +342,41 @@ TEST_CASE("Test editor::is_argument_valid() function"){
     s5 = "--substitute=+";
     REQUIRE_FALSE(editor::is_argument_valid(s5));
 
+    // --top
+    std::string s7{"--top=10"};
+    REQUIRE(editor::is_argument_valid(s7));
+    s7 = "--top";
+    REQUIRE_FALSE(editor::is_argument_valid(s7));
+    s7 = "--top=";
+    REQUIRE_FALSE(editor::is_argument_valid(s7));
+    s7 = "--top=-1";
+    REQUIRE_FALSE(editor::is_argument_valid(s7));
+    s7 = "--top=ten";
+    REQUIRE_FALSE(editor::is_argument_valid(s7));
+    s7 = "--top=99999999999";
+    REQUIRE_FALSE(editor::is_argument_valid(s7));
+
+    // --substitute-file
+    std::string s8{"--substitute-file=rules.txt"};
+    REQUIRE(editor::is_argument_valid(s8));
+    s8 = "--substitute-file";
+    REQUIRE_FALSE(editor::is_argument_valid(s8));
+    s8 = "--substitute-file=";
+    REQUIRE_FALSE(editor::is_argument_valid(s8));
+
+    // --remove-regex and --substitute-regex, whose pattern may contain `+`
+    std::string s9{"--remove-regex=un.*"};
+    REQUIRE(editor::is_argument_valid(s9));
+    s9 = "--remove-regex=";
+    REQUIRE_FALSE(editor::is_argument_valid(s9));
+    s9 = "--substitute-regex=a+b+c";
+    REQUIRE(editor::is_argument_valid(s9));
+    REQUIRE(editor::parse_argument(s9) == std::vector<std::string>{"--substitute-regex", "a+b", "c"});
+    s9 = "--substitute-regex=a+";
+    REQUIRE_FALSE(editor::is_argument_valid(s9));
+    s9 = "--substitute-regex=ab";
+    REQUIRE_FALSE(editor::is_argument_valid(s9));
+
     // non-existing flags
     std::string s6{""};
     REQUIRE_FALSE(editor::is_argument_valid(s6));
@@ -355,4 +458,28 @@ TEST_CASE("Test editor::substitute_word() function"){
     REQUIRE(result.at(2) == "word");
     REQUIRE(original.at(1) == result.at(1));
 }
-// ============== END OF FILE ==============
\ No newline at end of file
+
+TEST_CASE("Test editor::remove_word() and editor::substitute_word() functions in place"){
+    std::vector<std::string> text{"w1", "w2", "w1", "w3"};
+    const std::string* const data{text.data()};
+
+    // the words are edited in the same vector
+    text = editor::substitute_word(std::move(text), "w1", "word");
+    REQUIRE(text == std::vector<std::string>{"word", "w2", "word", "w3"});
+    REQUIRE(text.data() == data);
+
+    text = editor::remove_word(std::move(text), "word");
+    REQUIRE(text == std::vector<std::string>{"w2", "w3"});
+    REQUIRE(text.data() == data);
+
+    // views of words
+    std::vector<std::string_view> views{"w1", "w2", "w1"};
+    const std::string_view* const views_data{views.data()};
+
+    views = editor::substitute_word(std::move(views), "w2", "w1");
+    views = editor::remove_word(std::move(views), "w1");
+    REQUIRE(views.empty());
+    REQUIRE(views.capacity() == 3);
+    REQUIRE(views.data() == views_data);
+}
+// ============== END OF FILE ==============
@@ -0,0 +1,395 @@
+/**
+ * frequency_table.cpp
+ * -------------------
+ * Description:
+ *
+ *     ----- Frequency Table -----
+ *
+ *  A hash table from words to their frequencies, built for counting many words.
+ *
+ *  The entries are stored densely, in insertion order, as (word, frequency) pairs.
+ *  The words themselves are interned: each distinct word is copied once into large
+ *  blocks of memory owned by the table, and the entries only hold views of them, so
+ *  there is no allocation per word.
+ *
+ *  The entries are found through an open-addressing index: an array of slots with
+ *  the position of an entry, and an array of control bytes telling whether a slot
+ *  is empty, deleted or full, and for full slots, seven bits of the hash of its word.
+ *  A lookup compares the control bytes of 16 slots at once (with SSE2 when it is
+ *  available), and only compares words whose hash bits match.
+ *
+ **/
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include "frequency_table.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr std::int8_t empty_slot{-128};
+    constexpr std::int8_t deleted_slot{-2};
+    constexpr std::size_t group_size{16};
+    constexpr std::size_t min_capacity{16};
+    constexpr std::size_t block_size{1 << 16};
+    constexpr std::size_t npos{static_cast<std::size_t>(-1)};
+
+    // bit i is set when control byte i of the group is equal to `value`.
+    std::uint32_t match(const std::int8_t* group, const std::int8_t value){
+#if defined(__SSE2__)
+        const __m128i bytes{_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))};
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+        std::uint32_t mask{0};
+        for(std::size_t i{0}; i < group_size; i++){
+            mask |= static_cast<std::uint32_t>(group[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // the seven hash bits stored in the control byte of a full slot.
+    std::int8_t tag(const std::size_t hash){
+        return static_cast<std::int8_t>(hash & 0x7F);
+    }
+
+    std::size_t hash_word(const std::string_view word){
+        return std::hash<std::string_view>{}(word);
+    }
+}
+
+namespace editor {
+    /**
+     * @brief Create an empty table.
+     *
+     * No memory is allocated until the first word is added.
+     */
+    FrequencyTable::FrequencyTable()
+        : _entries{}, _slots{}, _control{}, _num_deleted{0}, _blocks{}, _block_next{nullptr}, _block_free{0}
+        {}
+
+    /**
+     * @brief Create a copy of a table, with its own copy of the words.
+     */
+    FrequencyTable::FrequencyTable(const FrequencyTable& other)
+        : FrequencyTable()
+    {
+        reserve(other.size());
+        for(const auto& [word, count] : other){
+            add(word, count);
+        }
+    }
+
+    // the words are owned by the blocks, which are moved along with the views of them.
+    FrequencyTable::FrequencyTable(FrequencyTable&& other) noexcept
+        : _entries{std::move(other._entries)}, _slots{std::move(other._slots)}, _control{std::move(other._control)},
+          _num_deleted{other._num_deleted}, _blocks{std::move(other._blocks)}, _block_next{other._block_next},
+          _block_free{other._block_free}
+    {
+        other._block_next = nullptr;
+        other._block_free = 0;
+        other._num_deleted = 0;
+    }
+
+    FrequencyTable& FrequencyTable::operator=(FrequencyTable other) noexcept{
+        std::swap(_entries, other._entries);
+        std::swap(_slots, other._slots);
+        std::swap(_control, other._control);
+        std::swap(_num_deleted, other._num_deleted);
+        std::swap(_blocks, other._blocks);
+        std::swap(_block_next, other._block_next);
+        std::swap(_block_free, other._block_free);
+        return *this;
+    }
+
+    /**
+     * @brief Add occurrences of a word.
+     *
+     * @param word: the word, copied into the table the first time it is added.
+     * @param count: number of occurrences to add.
+     */
+    void FrequencyTable::add(const std::string_view word, const int count){
+        const std::size_t hash{hash_word(word)};
+        const std::size_t slot{_find(word, hash)};
+
+        if(slot != npos){
+            _entries[_slots[slot]].second += count;
+        }
+        else{
+            _insert(_intern(word), count, hash);
+        }
+    }
+
+    /**
+     * @brief Add all occurrences of the words of another table.
+     *
+     * @param other: the table to add.
+     */
+    void FrequencyTable::merge(const FrequencyTable& other){
+        for(const auto& [word, count] : other){
+            add(word, count);
+        }
+    }
+
+    /**
+     * @brief Add all occurrences of the words of another table, taking over its words.
+     *
+     * The words of the other table are not copied, the table takes over the memory
+     * they are stored in instead. The other table is left empty.
+     *
+     * @param other: the table to add.
+     */
+    void FrequencyTable::merge(FrequencyTable&& other){
+        std::ranges::move(other._blocks, std::back_inserter(_blocks));
+
+        for(const auto& [word, count] : other._entries){
+            const std::size_t hash{hash_word(word)};
+            const std::size_t slot{_find(word, hash)};
+
+            if(slot != npos){
+                _entries[_slots[slot]].second += count;
+            }
+            else{
+                _insert(word, count, hash);
+            }
+        }
+
+        other = FrequencyTable{};
+    }
+
+    /**
+     * @brief Remove a word from the table.
+     *
+     * The last entry is moved into the place of the removed one, and the memory of
+     * the word is only released with the table.
+     *
+     * @param word: the word to remove.
+     * @return true if the word was in the table, else false.
+     */
+    bool FrequencyTable::erase(const std::string_view word){
+        const std::size_t slot{_find(word, hash_word(word))};
+
+        if(slot == npos){
+            return false;
+        }
+
+        const std::uint32_t index{_slots[slot]};
+        _set_control(slot, deleted_slot);
+        _num_deleted++;
+
+        if(index + 1 != _entries.size()){
+            const std::string_view last{_entries.back().first};
+            _slots[_find(last, hash_word(last))] = index;
+            _entries[index] = _entries.back();
+        }
+        _entries.pop_back();
+
+        return true;
+    }
+
+    /**
+     * @brief Change the frequencies of words, in O(size of the delta).
+     *
+     * Words are added when they are not in the table, and removed when their
+     * frequency becomes zero.
+     *
+     * @param delta: the change of frequency of each word.
+     */
+    void FrequencyTable::apply(const FrequencyDelta& delta){
+        for(const auto& [word, change] : delta){
+            const std::size_t hash{hash_word(word)};
+            const std::size_t slot{_find(word, hash)};
+
+            if(slot == npos){
+                if(change != 0){
+                    _insert(_intern(word), change, hash);
+                }
+            }
+            else if((_entries[_slots[slot]].second += change) == 0){
+                erase(word);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the frequency of a word.
+     *
+     * @param word: the word.
+     * @return the frequency.
+     * @throws std::out_of_range if the word is not in the table.
+     */
+    int FrequencyTable::at(const std::string_view word) const{
+        const std::size_t slot{_find(word, hash_word(word))};
+
+        if(slot == npos){
+            throw std::out_of_range("Word `" + std::string{word} + "` is not in the table.");
+        }
+
+        return _entries[_slots[slot]].second;
+    }
+
+    bool FrequencyTable::contains(const std::string_view word) const{
+        return _find(word, hash_word(word)) != npos;
+    }
+
+    std::size_t FrequencyTable::size() const{
+        return _entries.size();
+    }
+
+    bool FrequencyTable::empty() const{
+        return _entries.empty();
+    }
+
+    /**
+     * @brief Make room for a number of words, so that adding them does not grow the index.
+     *
+     * @param num_words: number of distinct words.
+     */
+    void FrequencyTable::reserve(const std::size_t num_words){
+        _entries.reserve(num_words);
+        if((num_words + _num_deleted) * 8 > _slots.size() * 7){
+            _rehash(std::max(min_capacity, std::bit_ceil(num_words * 8 / 7 + 1)));
+        }
+    }
+
+    // the entries, in insertion order, except that erasing moves the last entry.
+    FrequencyTable::const_iterator FrequencyTable::begin() const{
+        return _entries.begin();
+    }
+
+    FrequencyTable::const_iterator FrequencyTable::end() const{
+        return _entries.end();
+    }
+
+    // two tables are equal if they have the same words with the same frequencies, in any order.
+    bool FrequencyTable::operator==(const FrequencyTable& other) const{
+        if(size() != other.size()){
+            return false;
+        }
+
+        return std::ranges::all_of(_entries, [&other](const value_type& entry){
+            const std::size_t slot{other._find(entry.first, hash_word(entry.first))};
+            return slot != npos && other._entries[other._slots[slot]].second == entry.second;
+        });
+    }
+
+    // slot of a word, or npos if the word is not in the table.
+    std::size_t FrequencyTable::_find(const std::string_view word, const std::size_t hash) const{
+        if(_slots.empty()){
+            return npos;
+        }
+
+        const std::size_t mask{_slots.size() - 1};
+        std::size_t pos{(hash >> 7) & mask};
+
+        for(std::size_t probe{1}; ; probe++){
+            const std::int8_t* group{_control.data() + pos};
+
+            for(std::uint32_t matches{match(group, tag(hash))}; matches != 0; matches &= matches - 1){
+                const std::size_t slot{(pos + std::countr_zero(matches)) & mask};
+                if(_entries[_slots[slot]].first == word){
+                    return slot;
+                }
+            }
+
+            if(match(group, empty_slot) != 0){
+                return npos;
+            }
+
+            pos = (pos + group_size * probe) & mask;
+        }
+    }
+
+    // first empty or deleted slot in the probe sequence of a hash.
+    std::size_t FrequencyTable::_find_free(const std::size_t hash) const{
+        const std::size_t mask{_slots.size() - 1};
+        std::size_t pos{(hash >> 7) & mask};
+
+        for(std::size_t probe{1}; ; probe++){
+            const std::int8_t* group{_control.data() + pos};
+            const std::uint32_t matches{match(group, empty_slot) | match(group, deleted_slot)};
+
+            if(matches != 0){
+                return (pos + std::countr_zero(matches)) & mask;
+            }
+
+            pos = (pos + group_size * probe) & mask;
+        }
+    }
+
+    // add a new entry for a word that is not in the table, growing the index when it is 7/8 full
+    // or cleaning it from deleted slots.
+    void FrequencyTable::_insert(const std::string_view word, const int count, const std::size_t hash){
+        if((_entries.size() + _num_deleted + 1) * 8 > _slots.size() * 7){
+            _rehash(std::max(min_capacity, _entries.size() * 2 >= _slots.size() ? _slots.size() * 2 : _slots.size()));
+        }
+
+        const std::size_t slot{_find_free(hash)};
+        if(_control[slot] == deleted_slot){
+            _num_deleted--;
+        }
+
+        _set_control(slot, tag(hash));
+        _slots[slot] = static_cast<std::uint32_t>(_entries.size());
+        _entries.emplace_back(word, count);
+    }
+
+    // the first group_size - 1 control bytes are repeated after the last one, so that a group can
+    // be read from any slot without wrapping around.
+    void FrequencyTable::_set_control(const std::size_t slot, const std::int8_t value){
+        _control[slot] = value;
+        if(slot < group_size - 1){
+            _control[_slots.size() + slot] = value;
+        }
+    }
+
+    // rebuild the index with a capacity that is a power of two, dropping all deleted slots.
+    void FrequencyTable::_rehash(const std::size_t capacity){
+        _slots.assign(capacity, 0);
+        _control.assign(capacity + group_size - 1, empty_slot);
+        _num_deleted = 0;
+
+        for(std::size_t i{0}; i < _entries.size(); i++){
+            const std::size_t hash{hash_word(_entries[i].first)};
+            const std::size_t slot{_find_free(hash)};
+            _set_control(slot, tag(hash));
+            _slots[slot] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // copy a word into the blocks, long words get a block of their own.
+    std::string_view FrequencyTable::_intern(const std::string_view word){
+        // an empty word needs no storage, and there may be no block to point into yet.
+        if(word.empty()){
+            return {};
+        }
+
+        if(word.size() > _block_free){
+            if(word.size() > block_size / 4){
+                _blocks.push_back(std::make_unique_for_overwrite<char[]>(word.size()));
+                std::memcpy(_blocks.back().get(), word.data(), word.size());
+                return {_blocks.back().get(), word.size()};
+            }
+
+            _blocks.push_back(std::make_unique_for_overwrite<char[]>(block_size));
+            _block_next = _blocks.back().get();
+            _block_free = block_size;
+        }
+
+        std::memcpy(_block_next, word.data(), word.size());
+        const std::string_view interned{_block_next, word.size()};
+        _block_next += word.size();
+        _block_free -= word.size();
+
+        return interned;
+    }
+}
+
+// ============== END OF FILE ==============
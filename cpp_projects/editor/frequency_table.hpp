@@ -0,0 +1,81 @@
+/**
+ * frequency_table.hpp
+ * -------------------
+ * Description:
+ *   Header file containing declarations for the word frequency table.
+ * */
+
+#ifndef FREQUENCY_TABLE_HPP
+#define FREQUENCY_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace editor {
+    // changes of the frequencies of words, made by editing a text.
+    using FrequencyDelta = std::vector<std::pair<std::string_view, int>>;
+
+    class FrequencyTable{
+    public:
+        using value_type = std::pair<std::string_view, int>;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        FrequencyTable();
+
+        FrequencyTable(const FrequencyTable& other);
+        FrequencyTable(FrequencyTable&& other) noexcept;
+        FrequencyTable& operator=(FrequencyTable other) noexcept;
+
+        ~FrequencyTable() = default;
+
+        void add(std::string_view word, int count = 1);
+
+        void merge(const FrequencyTable& other);
+        void merge(FrequencyTable&& other);
+
+        bool erase(std::string_view word);
+
+        void apply(const FrequencyDelta& delta);
+
+        int at(std::string_view word) const;
+
+        bool contains(std::string_view word) const;
+
+        std::size_t size() const;
+
+        bool empty() const;
+
+        void reserve(std::size_t num_words);
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        bool operator==(const FrequencyTable& other) const;
+
+    private:
+        std::vector<value_type> _entries;
+        std::vector<std::uint32_t> _slots;
+        std::vector<std::int8_t> _control;
+        std::size_t _num_deleted;
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        char* _block_next;
+        std::size_t _block_free;
+
+        std::size_t _find(std::string_view word, std::size_t hash) const;
+        std::size_t _find_free(std::size_t hash) const;
+        void _insert(std::string_view word, int count, std::size_t hash);
+        void _set_control(std::size_t slot, std::int8_t value);
+        void _rehash(std::size_t capacity);
+        std::string_view _intern(std::string_view word);
+    };
+}
+
+#endif // FREQUENCY_TABLE_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,122 @@
+#include "frequency_table.hpp"
+#include "../../test/catch.hpp"
+#include <string>
+#include <unordered_map>
+
+TEST_CASE("Test editor::FrequencyTable adding and finding words"){
+    editor::FrequencyTable table{};
+    REQUIRE(table.empty());
+    REQUIRE_FALSE(table.contains("word"));
+    REQUIRE_THROWS_WITH(table.at("word"), "Word `word` is not in the table.");
+
+    table.add("word");
+    table.add("other", 3);
+    table.add("word");
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.at("word") == 2);
+    REQUIRE(table.at("other") == 3);
+
+    // the table keeps its own copy of the words
+    std::string temporary{"temporary"};
+    table.add(temporary);
+    temporary = "overwritten";
+    REQUIRE(table.at("temporary") == 1);
+    REQUIRE_FALSE(table.contains("overwritten"));
+
+    // empty and long words
+    const std::string long_word(100000, 'x');
+    table.add("");
+    table.add(long_word);
+    REQUIRE(table.at("") == 1);
+    REQUIRE(table.at(long_word) == 1);
+}
+
+TEST_CASE("Test editor::FrequencyTable adding an empty word to a new table"){
+    // a new table has no storage for words yet
+    editor::FrequencyTable table{};
+    table.add("");
+    REQUIRE(table.size() == 1);
+    REQUIRE(table.at("") == 1);
+}
+
+TEST_CASE("Test editor::FrequencyTable growing and erasing"){
+    editor::FrequencyTable table{};
+    std::unordered_map<std::string, int> expected{};
+
+    for(int i{0}; i < 50000; i++){
+        const std::string word{"w" + std::to_string(i * 7919 % 20011)};
+        table.add(word);
+        expected[word]++;
+    }
+    REQUIRE(table.size() == expected.size());
+
+    // erase every other word, then add some of them back
+    int erased{0};
+    for(const auto& [word, count] : expected){
+        if(erased++ % 2 == 0){
+            REQUIRE(table.erase(word));
+            REQUIRE_FALSE(table.erase(word));
+        }
+    }
+    for(const auto& [word, count] : expected){
+        if(!table.contains(word)){
+            table.add(word, count);
+        }
+    }
+
+    REQUIRE(table.size() == expected.size());
+    for(const auto& [word, count] : expected){
+        REQUIRE(table.at(word) == count);
+    }
+}
+
+TEST_CASE("Test editor::FrequencyTable copying, moving and merging"){
+    editor::FrequencyTable first{};
+    first.add("a", 2);
+    first.add("b");
+
+    editor::FrequencyTable second{};
+    second.add("b", 4);
+    second.add("c");
+
+    editor::FrequencyTable copy{first};
+    REQUIRE(copy == first);
+
+    copy.merge(second);
+    REQUIRE(copy.at("b") == 5);
+    REQUIRE(second.size() == 2);
+
+    editor::FrequencyTable moved{std::move(first)};
+    moved.merge(std::move(second));
+    REQUIRE(second.empty());
+    REQUIRE(moved == copy);
+
+    // words taken over from the merged table stay valid after it is gone
+    {
+        editor::FrequencyTable other{};
+        other.add(std::string{"taken"});
+        moved.merge(std::move(other));
+    }
+    REQUIRE(moved.at("taken") == 1);
+    REQUIRE_FALSE(moved == copy);
+
+    copy = moved;
+    REQUIRE(copy == moved);
+}
+
+TEST_CASE("Test editor::FrequencyTable applying deltas"){
+    editor::FrequencyTable table{};
+    table.add("a", 3);
+    table.add("b", 1);
+
+    table.apply({{"a", -3}, {"b", 2}, {"c", 4}, {"d", 0}});
+    REQUIRE(table.size() == 2);
+    REQUIRE_FALSE(table.contains("a"));
+    REQUIRE(table.at("b") == 3);
+    REQUIRE(table.at("c") == 4);
+    REQUIRE_FALSE(table.contains("d"));
+
+    // a word removed and added back in the same delta
+    table.apply({{"b", -3}, {"b", 1}});
+    REQUIRE(table.at("b") == 1);
+}
@@ -0,0 +1,74 @@
+/**
+ * mapped_file.cpp
+ * ---------------
+ * Description:
+ *
+ *     ----- Memory-Mapped File -----
+ *
+ *  Maps a whole file into memory, read-only, for as long as the object lives.
+ *  The content is read from disk by the operating system when it is first used,
+ *  so no copy of the file is made and peak memory is close to the file size.
+ *
+ **/
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#include "mapped_file.hpp"
+
+namespace editor {
+    /**
+     * @brief Map a file into memory.
+     *
+     * @param path: path of the file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    MappedFile::MappedFile(const std::string& path)
+        : _data{nullptr}, _size{0}
+    {
+        const int fd{open(path.c_str(), O_RDONLY)};
+        struct stat info{};
+
+        if(fd < 0 || fstat(fd, &info) < 0){
+            if(fd >= 0){
+                close(fd);
+            }
+            throw std::runtime_error("File `" + path + "` not found.");
+        }
+
+        _size = static_cast<std::size_t>(info.st_size);
+
+        // an empty file cannot be mapped, it is represented by an empty view.
+        if(_size > 0){
+            _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+
+        if(_data == MAP_FAILED){
+            throw std::runtime_error("File `" + path + "` cannot be mapped.");
+        }
+
+        if(_data != nullptr){
+            madvise(_data, _size, MADV_SEQUENTIAL);
+        }
+    }
+
+    MappedFile::~MappedFile(){
+        if(_data != nullptr){
+            munmap(_data, _size);
+        }
+    }
+
+    /**
+     * @brief Get the content of the file.
+     *
+     * @return view of the content, valid for as long as the object lives.
+     */
+    std::string_view MappedFile::view() const{
+        return {static_cast<const char*>(_data), _size};
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,35 @@
+/**
+ * mapped_file.hpp
+ * ---------------
+ * Description:
+ *   Header file containing declarations for read-only memory-mapped files.
+ * */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace editor {
+    class MappedFile{
+    public:
+        explicit MappedFile(const std::string& path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile();
+
+        std::string_view view() const;
+
+    private:
+        void* _data;
+        std::size_t _size;
+    };
+}
+
+#endif // MAPPED_FILE_HPP
+
+// ============== END OF FILE ==============
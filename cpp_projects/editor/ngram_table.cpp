@@ -0,0 +1,436 @@
+/**
+ * ngram_table.cpp
+ * ---------------
+ * Description:
+ *
+ *     ----- N-gram Table -----
+ *
+ *  Counts the n-grams of a text, the sequences of n consecutive words, for n up to 4.
+ *
+ *  Every distinct word is stored once and given a 32-bit ID, and an n-gram is the
+ *  tuple of the IDs of its words, packed into one 64-bit key for n up to 2, and into
+ *  two 64-bit words for longer n-grams. The keys and their counts are kept in flat
+ *  arrays, as an open addressing table with linear probing, so an n-gram costs 16
+ *  or 24 bytes however long its words are, and counting looks up a word only once.
+ *  A key is empty when its first word has all bits set, which no n-gram has, since
+ *  no word gets the largest ID.
+ *
+ *  A table can be bounded to a number of distinct n-grams, with the Misra-Gries
+ *  algorithm for frequent items, counting in batches. When the table grows past its
+ *  bound, all counts are decreased by the median count, and the n-grams whose count
+ *  reaches zero are dropped, which is at least half of them. A decrease lowers the
+ *  count of any n-gram by at most its amount, dropped or not, so every count is lower
+ *  than the true count by at most the sum of all decreases, which is the error of
+ *  the table. Each decrease by m removes at least m from half of the counts, so the
+ *  error is at most 2 N / (max_entries + 1) for a text of N n-grams, and an n-gram
+ *  more frequent than that is never missing. Without a bound, counts are exact.
+ *
+ *  N-grams never span two texts: counting a text starts with an empty window.
+ *
+ **/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include "ngram_table.hpp"
+#include "output_buffer.hpp"
+#include "word_stream.hpp"
+
+namespace editor {
+    namespace helper {
+        constexpr std::uint64_t empty_key{std::numeric_limits<std::uint64_t>::max()};
+
+        // smallest number of words for which counting is automatically split over several threads.
+        constexpr std::size_t min_parallel_ngrams{1 << 16};
+
+        std::size_t hash_key(const std::uint64_t* key, const std::size_t stride){
+            std::uint64_t hash{key[0]};
+            if(stride == 2){
+                hash ^= key[1] * 0x9E3779B97F4A7C15ULL;
+            }
+            // the finalizer of MurmurHash3, to spread the bits of the IDs.
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33;
+            return static_cast<std::size_t>(hash);
+        }
+
+        // order of n-grams by descending count, then by descending n-gram for equal counts.
+        bool more_frequent_ngram(const std::pair<std::string, std::uint64_t>& pair1,
+                           const std::pair<std::string, std::uint64_t>& pair2){
+            return pair1.second != pair2.second ? pair1.second > pair2.second : pair1.first > pair2.first;
+        }
+
+        template<typename Word>
+        NgramTable count_ngrams(const std::vector<Word>& text_vector, const std::size_t n, unsigned num_threads){
+            if(num_threads == 0){
+                num_threads = text_vector.size() < min_parallel_ngrams ? 1 : std::thread::hardware_concurrency();
+            }
+            const std::size_t num_parts{std::clamp<std::size_t>(num_threads, 1,
+                                        std::max<std::size_t>(text_vector.size() / min_parallel_ngrams, 1))};
+
+            std::vector<NgramTable> tables{};
+            tables.reserve(num_parts);
+            for(std::size_t t{0}; t < num_parts; t++){
+                tables.emplace_back(n);
+            }
+            const std::span<const Word> words{text_vector};
+            {
+                std::vector<std::jthread> threads{};
+                for(std::size_t t{0}; t < num_parts; t++){
+                    // every part also reads the first words of the next one, to count the n-grams starting in it.
+                    const std::size_t begin{words.size() * t / num_parts};
+                    const std::size_t end{std::min(words.size() * (t + 1) / num_parts + n - 1, words.size())};
+                    threads.emplace_back([&tables, words, t, begin, end]{
+                        tables[t].add(words.subspan(begin, end - begin));
+                    });
+                }
+            }
+
+            for(std::size_t t{1}; t < num_parts; t++){
+                tables[0].merge(tables[t]);
+            }
+            return std::move(tables[0]);
+        }
+    }
+
+    /**
+     * @brief Create an empty table of n-grams.
+     *
+     * @param n: number of words of every n-gram, from 1 to `max_n`.
+     * @param max_entries: number of n-grams above which rare ones are dropped, zero for no limit.
+     * @throws std::invalid_argument if n is out of range.
+     */
+    NgramTable::NgramTable(const std::size_t n, const std::size_t max_entries)
+        : _n{n}, _max_entries{max_entries}, _error{0}, _words{}, _ids{}, _stride{n <= 2 ? 1U : 2U},
+          _keys{}, _counts{}, _size{0}, _window{}, _window_size{0}
+    {
+        if(n == 0 || n > max_n){
+            throw std::invalid_argument("N-grams must have from 1 to " + std::to_string(max_n) + " words.");
+        }
+        _keys.assign(16 * _stride, helper::empty_key);
+        _counts.assign(16, 0);
+    }
+
+    std::size_t NgramTable::n() const{
+        return _n;
+    }
+
+    // number of distinct n-grams.
+    std::size_t NgramTable::size() const{
+        return _size;
+    }
+
+    // largest amount by which any count may be lower than the true count, zero if all counts are exact.
+    std::uint64_t NgramTable::error() const{
+        return _error;
+    }
+
+    /**
+     * @brief Count the n-grams of a text.
+     *
+     * @param text: the words of the text.
+     */
+    void NgramTable::add(const std::span<const std::string> text){
+        std::ranges::for_each(text, [this](const std::string& word){_add_word(word);});
+        _end_text();
+    }
+
+    /**
+     * @brief Count the n-grams of a text of views.
+     *
+     * @param text: views of the words of the text.
+     */
+    void NgramTable::add(const std::span<const std::string_view> text){
+        std::ranges::for_each(text, [this](const std::string_view word){_add_word(word);});
+        _end_text();
+    }
+
+    /**
+     * @brief Count the n-grams of a text read from a stream, one chunk at a time.
+     *
+     * @param is: an input stream of text.
+     * @param edits: the edits applied to the words before they are counted.
+     * @param normalizer: normalizes the words before they are edited, if given.
+     */
+    void NgramTable::add(std::istream& is, const WordEdits& edits, Normalizer* const normalizer){
+        WordStream stream{is};
+        std::vector<std::string_view> words{};
+
+        while(stream.next(words)){
+            if(normalizer){
+                normalizer->apply(words);
+            }
+            edits.apply(words);
+            std::ranges::for_each(words, [this](const std::string_view word){_add_word(word);});
+        }
+        _end_text();
+    }
+
+    /**
+     * @brief Add the counts of another table of n-grams of the same length.
+     *
+     * The words of the other table are given IDs of this table, so this takes
+     * O(number of n-grams of the other table).
+     *
+     * @param other: another table.
+     * @throws std::invalid_argument if the n-grams of the tables have different lengths.
+     */
+    void NgramTable::merge(const NgramTable& other){
+        if(other._n != _n){
+            throw std::invalid_argument("Cannot merge n-grams of different lengths.");
+        }
+
+        std::vector<std::uint32_t> ids(other._words.size());
+        for(std::size_t id{0}; id < ids.size(); id++){
+            ids[id] = _id(other._words[id]);
+        }
+
+        for(std::size_t slot{0}; slot < other._counts.size(); slot++){
+            const std::uint64_t* const key{&other._keys[slot * _stride]};
+            if(key[0] == helper::empty_key){
+                continue;
+            }
+
+            Key mapped{};
+            for(std::size_t i{0}; i < _n; i++){
+                const std::uint64_t id{(key[i / 2] >> (32 * (i % 2))) & 0xFFFFFFFF};
+                mapped[i / 2] |= static_cast<std::uint64_t>(ids[id]) << (32 * (i % 2));
+            }
+            _add_key(mapped, other._counts[slot]);
+        }
+        // the counts of both tables may be too low, each by at most its own error
+        _error += other._error;
+    }
+
+    /**
+     * @brief Get the most frequent n-grams.
+     *
+     * @param k: the number of n-grams to get, at most.
+     * @return pairs of (n-gram, count), with the words of an n-gram separated by a space,
+     *         sorted by descending count, and by descending n-gram for equal counts.
+     */
+    std::vector<std::pair<std::string, std::uint64_t>> NgramTable::top(const std::size_t k) const{
+        // only n-grams with at least the count of the k-th most frequent one are joined into strings.
+        std::vector<std::uint64_t> counts{};
+        counts.reserve(_size);
+        for(const std::uint64_t count : _counts){
+            if(count > 0){
+                counts.push_back(count);
+            }
+        }
+        const std::size_t kept{std::min(k, counts.size())};
+        if(kept == 0){
+            return {};
+        }
+        std::ranges::nth_element(counts, counts.begin() + static_cast<std::ptrdiff_t>(kept - 1), std::greater<>{});
+        const std::uint64_t threshold{counts[kept - 1]};
+
+        std::vector<std::pair<std::string, std::uint64_t>> result{};
+        for(std::size_t slot{0}; slot < _counts.size(); slot++){
+            if(_counts[slot] >= threshold && _counts[slot] > 0){
+                Key key{};
+                std::copy_n(&_keys[slot * _stride], _stride, key.begin());
+                result.emplace_back(_join(key), _counts[slot]);
+            }
+        }
+
+        std::ranges::sort(result, helper::more_frequent_ngram);
+        result.resize(kept);
+        return result;
+    }
+
+    // ------------------- PRIVATE FUNCTIONS -------------------
+
+    // get the ID of a word, giving it the next one if it is new.
+    std::uint32_t NgramTable::_id(const std::string_view word){
+        if(const auto it{_ids.find(word)}; it != _ids.end()){
+            return it->second;
+        }
+
+        if(_words.size() >= std::numeric_limits<std::uint32_t>::max()){
+            throw std::length_error("Too many distinct words for n-grams.");
+        }
+        const auto id{static_cast<std::uint32_t>(_words.size())};
+        _ids.emplace(_words.emplace_back(word), id);
+        return id;
+    }
+
+    // count the n-gram that ends with the next word of the current text.
+    void NgramTable::_add_word(const std::string_view word){
+        if(_window_size == _n){
+            std::shift_left(_window.begin(), _window.begin() + static_cast<std::ptrdiff_t>(_n), 1);
+            _window_size--;
+        }
+        _window[_window_size++] = _id(word);
+
+        if(_window_size == _n){
+            Key key{};
+            for(std::size_t i{0}; i < _n; i++){
+                key[i / 2] |= static_cast<std::uint64_t>(_window[i]) << (32 * (i % 2));
+            }
+            _add_key(key, 1);
+        }
+    }
+
+    void NgramTable::_end_text(){
+        _window_size = 0;
+    }
+
+    void NgramTable::_add_key(const Key& key, const std::uint64_t count){
+        const std::size_t mask{_counts.size() - 1};
+
+        for(std::size_t slot{helper::hash_key(key.data(), _stride) & mask};; slot = (slot + 1) & mask){
+            std::uint64_t* const stored{&_keys[slot * _stride]};
+
+            if(stored[0] == helper::empty_key){
+                std::copy_n(key.begin(), _stride, stored);
+                _counts[slot] = count;
+                _size++;
+                break;
+            }
+            if(std::equal(stored, stored + _stride, key.begin())){
+                _counts[slot] += count;
+                return;
+            }
+        }
+
+        if(_max_entries > 0 && _size > _max_entries){
+            _prune();
+        }
+        else if(_size * 10 > _counts.size() * 7){
+            _grow();
+        }
+    }
+
+    // double the number of slots, and insert all keys again.
+    void NgramTable::_grow(){
+        std::vector<std::uint64_t> keys(_keys.size() * 2, helper::empty_key);
+        std::vector<std::uint64_t> counts(_counts.size() * 2, 0);
+        std::swap(keys, _keys);
+        std::swap(counts, _counts);
+        _size = 0;
+
+        for(std::size_t slot{0}; slot < counts.size(); slot++){
+            if(keys[slot * _stride] != helper::empty_key){
+                Key key{};
+                std::copy_n(&keys[slot * _stride], _stride, key.begin());
+                _add_key(key, counts[slot]);
+            }
+        }
+    }
+
+    // decrease all counts by the median count, dropping the n-grams whose count reaches zero.
+    void NgramTable::_prune(){
+        std::vector<std::uint64_t> counts{};
+        counts.reserve(_size);
+        for(std::size_t slot{0}; slot < _counts.size(); slot++){
+            if(_keys[slot * _stride] != helper::empty_key){
+                counts.push_back(_counts[slot]);
+            }
+        }
+        const auto median{counts.begin() + static_cast<std::ptrdiff_t>(counts.size() / 2)};
+        std::ranges::nth_element(counts, median);
+        const std::uint64_t decrease{*median};
+        _error += decrease;
+
+        std::vector<std::uint64_t> keys(_keys.size(), helper::empty_key);
+        std::vector<std::uint64_t> old_counts(_counts.size(), 0);
+        std::swap(keys, _keys);
+        std::swap(old_counts, _counts);
+        _size = 0;
+
+        // keys are inserted again without a limit, so that pruning does not start over.
+        const std::size_t max_entries{std::exchange(_max_entries, 0)};
+        for(std::size_t slot{0}; slot < old_counts.size(); slot++){
+            if(keys[slot * _stride] != helper::empty_key && old_counts[slot] > decrease){
+                Key key{};
+                std::copy_n(&keys[slot * _stride], _stride, key.begin());
+                _add_key(key, old_counts[slot] - decrease);
+            }
+        }
+        _max_entries = max_entries;
+    }
+
+    // the words of an n-gram, separated by a space.
+    std::string NgramTable::_join(const Key& key) const{
+        std::string ngram{};
+        for(std::size_t i{0}; i < _n; i++){
+            if(i > 0){
+                ngram.push_back(' ');
+            }
+            ngram.append(_words[(key[i / 2] >> (32 * (i % 2))) & 0xFFFFFFFF]);
+        }
+        return ngram;
+    }
+
+    // ------------------- FREE FUNCTIONS -------------------
+
+    /**
+     * @brief Count the n-grams of a text, on several threads for large texts.
+     *
+     * Every thread counts the n-grams starting in its part of the text, and the
+     * tables are merged.
+     *
+     * @param text_vector: a vector of words.
+     * @param n: number of words of every n-gram.
+     * @param num_threads: number of threads to use, zero chooses it from the size of the text.
+     * @return the table of n-grams.
+     */
+    NgramTable count_ngrams(const std::vector<std::string>& text_vector, const std::size_t n,
+                            const unsigned num_threads){
+        return helper::count_ngrams(text_vector, n, num_threads);
+    }
+
+    /**
+     * @brief Count the n-grams of a text of views, on several threads for large texts.
+     *
+     * @param text_vector: a vector of views of words.
+     * @param n: number of words of every n-gram.
+     * @param num_threads: number of threads to use, zero chooses it from the size of the text.
+     * @return the table of n-grams.
+     */
+    NgramTable count_ngrams(const std::vector<std::string_view>& text_vector, const std::size_t n,
+                            const unsigned num_threads){
+        return helper::count_ngrams(text_vector, n, num_threads);
+    }
+
+    /**
+     * @brief Print the most frequent n-grams of a table.
+     *
+     * Printed in the same format as `print_frequency`, with the n-grams right-aligned.
+     * When the counts of a bounded table may be too low, a last line gives by how much.
+     *
+     * @param table: a table of n-grams.
+     * @param k: the number of n-grams to print, at most.
+     * @param os: an output stream, by default std::cout is used.
+     */
+    void print_ngrams(const NgramTable& table, const std::size_t k, std::ostream& os){
+        const std::vector<std::pair<std::string, std::uint64_t>> ngrams{table.top(k)};
+        std::size_t max_length{0};
+        for(const auto& [ngram, count] : ngrams){
+            max_length = std::max(max_length, ngram.size());
+        }
+
+        OutputBuffer output{os};
+        for(const auto& [ngram, count] : ngrams){
+            output.pad(max_length - ngram.size());
+            output.write(ngram);
+            output.write(' ');
+            output.write(count);
+            output.write('\n');
+        }
+
+        if(table.error() > 0){
+            output.write("Counts may be lower than the true counts by at most ");
+            output.write(table.error());
+            output.write(".\n");
+        }
+    }
+}
+
+// ============== END OF FILE ==============
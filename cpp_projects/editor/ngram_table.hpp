@@ -0,0 +1,97 @@
+/**
+ * ngram_table.hpp
+ * ---------------
+ * Description:
+ *   Header file containing declarations for counting sequences of consecutive words.
+ * */
+
+#ifndef NGRAM_TABLE_HPP
+#define NGRAM_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "normalizer.hpp"
+#include "word_edits.hpp"
+
+namespace editor {
+    class NgramTable{
+    public:
+        // longest n-grams, whose word IDs fit into 128 bits.
+        static constexpr std::size_t max_n{4};
+
+        explicit NgramTable(std::size_t n, std::size_t max_entries = 0);
+
+        // the IDs refer to the words of the table itself, which a move keeps in place.
+        NgramTable(const NgramTable&) = delete;
+        NgramTable& operator=(const NgramTable&) = delete;
+
+        NgramTable(NgramTable&&) noexcept = default;
+        NgramTable& operator=(NgramTable&&) noexcept = default;
+
+        ~NgramTable() = default;
+
+        std::size_t n() const;
+
+        std::size_t size() const;
+
+        std::uint64_t error() const;
+
+        void add(std::span<const std::string> text);
+
+        void add(std::span<const std::string_view> text);
+
+        void add(std::istream& is, const WordEdits& edits, Normalizer* normalizer = nullptr);
+
+        void merge(const NgramTable& other);
+
+        std::vector<std::pair<std::string, std::uint64_t>> top(std::size_t k) const;
+
+    private:
+        using Key = std::array<std::uint64_t, 2>;
+
+        std::size_t _n;
+        std::size_t _max_entries;
+        std::uint64_t _error;
+
+        // interned words and their IDs.
+        std::deque<std::string> _words;
+        std::unordered_map<std::string_view, std::uint32_t> _ids;
+
+        // open addressing table of packed keys, one or two 64-bit words each, and their counts.
+        std::size_t _stride;
+        std::vector<std::uint64_t> _keys;
+        std::vector<std::uint64_t> _counts;
+        std::size_t _size;
+
+        // IDs of the last n - 1 words of the current text.
+        std::array<std::uint32_t, max_n> _window;
+        std::size_t _window_size;
+
+        std::uint32_t _id(std::string_view word);
+        void _add_word(std::string_view word);
+        void _end_text();
+        void _add_key(const Key& key, std::uint64_t count);
+        void _grow();
+        void _prune();
+        std::string _join(const Key& key) const;
+    };
+
+    NgramTable count_ngrams(const std::vector<std::string>& text_vector, std::size_t n, unsigned num_threads = 0);
+
+    NgramTable count_ngrams(const std::vector<std::string_view>& text_vector, std::size_t n, unsigned num_threads = 0);
+
+    void print_ngrams(const NgramTable& table, std::size_t k, std::ostream& os = std::cout);
+}
+
+#endif // NGRAM_TABLE_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,142 @@
+#include "ngram_table.hpp"
+#include "../../test/catch.hpp"
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace {
+    // count the n-grams of a text one string at a time.
+    std::map<std::string, std::uint64_t> expected_ngrams(const std::vector<std::string>& text, const std::size_t n){
+        std::map<std::string, std::uint64_t> counts{};
+        for(std::size_t i{0}; i + n <= text.size(); i++){
+            std::string ngram{text[i]};
+            for(std::size_t j{1}; j < n; j++){
+                ngram += " " + text[i + j];
+            }
+            counts[ngram]++;
+        }
+        return counts;
+    }
+
+    std::map<std::string, std::uint64_t> as_map(const editor::NgramTable& table){
+        const auto ngrams{table.top(table.size())};
+        return {ngrams.begin(), ngrams.end()};
+    }
+}
+
+TEST_CASE("Test editor::NgramTable counting n-grams"){
+    const std::vector<std::string> text{"the", "cat", "and", "the", "cat", "and", "the", "hat"};
+
+    editor::NgramTable bigrams{2};
+    bigrams.add(text);
+    REQUIRE(bigrams.size() == 4);
+    REQUIRE(bigrams.error() == 0);
+    REQUIRE(bigrams.top(3) == std::vector<std::pair<std::string, std::uint64_t>>{
+        {"the cat", 2}, {"cat and", 2}, {"and the", 2}});
+
+    // n-grams do not span two texts
+    bigrams.add(std::vector<std::string>{"hat", "the"});
+    REQUIRE(as_map(bigrams).at("hat the") == 1);
+    REQUIRE_FALSE(as_map(bigrams).contains("hat hat"));
+
+    editor::NgramTable fourgrams{4};
+    fourgrams.add(text);
+    REQUIRE(as_map(fourgrams) == expected_ngrams(text, 4));
+
+    editor::NgramTable short_text{3};
+    short_text.add(std::vector<std::string>{"too", "short"});
+    REQUIRE(short_text.size() == 0);
+    REQUIRE(short_text.top(10).empty());
+
+    REQUIRE_THROWS_WITH(editor::NgramTable{0}, "N-grams must have from 1 to 4 words.");
+    REQUIRE_THROWS_WITH(editor::NgramTable{5}, "N-grams must have from 1 to 4 words.");
+    REQUIRE_THROWS_WITH(bigrams.merge(fourgrams), "Cannot merge n-grams of different lengths.");
+
+    std::ostringstream os{};
+    editor::print_ngrams(fourgrams, 2, os);
+    REQUIRE(os.str() == "the cat and the 2\ncat and the hat 1\n");
+}
+
+TEST_CASE("Test editor::NgramTable on larger texts"){
+    std::vector<std::string> text{};
+    for(int i{0}; i < 30000; i++){
+        text.push_back("w" + std::to_string(i * i % 53 + i % 7));
+    }
+    const std::vector<std::string_view> views(text.begin(), text.end());
+
+    for(std::size_t n{1}; n <= editor::NgramTable::max_n; n++){
+        const auto expected{expected_ngrams(text, n)};
+        REQUIRE(as_map(editor::count_ngrams(text, n, 1)) == expected);
+        REQUIRE(as_map(editor::count_ngrams(views, n, 4)) == expected);
+    }
+
+    // streams, with edits applied before counting
+    std::ostringstream content{};
+    for(const std::string& word : text){
+        content << word << ' ';
+    }
+    std::istringstream is{content.str()};
+    editor::WordEdits edits{};
+    edits.remove("w0");
+    std::vector<std::string> edited{text};
+    edits.apply(edited);
+
+    editor::NgramTable streamed{3};
+    streamed.add(is, edits);
+    REQUIRE(as_map(streamed) == expected_ngrams(edited, 3));
+}
+
+TEST_CASE("Test editor::NgramTable bounded to a number of n-grams"){
+    // `A` is dropped and comes again many times, among words that are seen twice
+    std::vector<std::string> text{};
+    for(int i{0}; i < 100; i++){
+        text.insert(text.end(), {"A", "x" + std::to_string(i), "x" + std::to_string(i + 1)});
+    }
+
+    // every count is at most the error lower than the true count, also for dropped n-grams
+    const auto check{[](const editor::NgramTable& bounded, const std::map<std::string, std::uint64_t>& expected,
+                        const std::size_t max_entries){
+        REQUIRE(bounded.size() <= max_entries);
+        const auto counts{as_map(bounded)};
+        std::uint64_t total{0};
+        for(const auto& [ngram, count] : expected){
+            const std::uint64_t bounded_count{counts.contains(ngram) ? counts.at(ngram) : 0};
+            INFO(ngram << ": " << bounded_count << " of " << count << ", error " << bounded.error());
+            REQUIRE(bounded_count <= count);
+            REQUIRE(bounded_count + bounded.error() >= count);
+            total += count;
+        }
+        REQUIRE(bounded.error() <= 2 * total / (max_entries + 1));
+    }};
+
+    for(const std::size_t max_entries : {2, 3, 10}){
+        editor::NgramTable unigrams{1, max_entries};
+        unigrams.add(text);
+        check(unigrams, expected_ngrams(text, 1), max_entries);
+
+        editor::NgramTable bigrams{2, max_entries};
+        bigrams.add(text);
+        check(bigrams, expected_ngrams(text, 2), max_entries);
+    }
+
+    // more frequent than the largest possible error, so never missing
+    editor::NgramTable bounded{1, 10};
+    bounded.add(text);
+    REQUIRE(bounded.top(1).at(0).first == "A");
+
+    // merged tables add their errors
+    editor::NgramTable merged{1, 10};
+    merged.add(std::span{text}.first(150));
+    editor::NgramTable second{1, 10};
+    second.add(std::span{text}.subspan(150));
+    const std::uint64_t errors{merged.error() + second.error()};
+    merged.merge(second);
+    REQUIRE(merged.error() >= errors);
+    check(merged, expected_ngrams(text, 1), 10);
+
+    // the error is printed after the counts
+    std::ostringstream os{};
+    editor::print_ngrams(bounded, 1, os);
+    REQUIRE(os.str() == "A " + std::to_string(bounded.top(1).at(0).second) + "\nCounts may be lower than the "
+                        "true counts by at most " + std::to_string(bounded.error()) + ".\n");
+}
@@ -0,0 +1,327 @@
+/**
+ * normalizer.cpp
+ * --------------
+ * Description:
+ *
+ *     ----- Normalizer -----
+ *
+ *  Brings words into a normal form before they are counted, so that "The" and "the",
+ *  or "C++" and "C++.", are the same word. Normalizing can fold the case of letters
+ *  and strip the punctuation that surrounds words in sentences: opening quotes and
+ *  brackets at the start of a word, and closing ones, periods, commas, colons,
+ *  semicolons, question and exclamation marks at its end. Punctuation within a word,
+ *  and symbols such as `+` or `#`, are kept. A word of only punctuation becomes empty
+ *  and is dropped.
+ *
+ *  Text is read as UTF-8. Case folding covers ASCII, Latin-1, Latin Extended-A, Greek
+ *  and Cyrillic letters, and typographic quotes, guillemets and ellipses are stripped
+ *  as well. Bytes that are not valid UTF-8 are kept as they are.
+ *
+ *  Most words of a text are already normal, which is found with one table lookup
+ *  per character, and then the word itself is returned without any copy. Only the
+ *  other words are transformed, and the normal forms of recently seen ones are kept
+ *  in a small cache, so that frequent words are only transformed once.
+ *
+ **/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "normalizer.hpp"
+
+namespace editor {
+    namespace helper {
+        // classes of bytes, which can be combined.
+        enum : std::uint8_t {upper = 1, leading = 2, trailing = 4, non_ascii = 8};
+
+        constexpr std::array<std::uint8_t, 256> byte_classes{[]{
+            std::array<std::uint8_t, 256> classes{};
+            for(int c{'A'}; c <= 'Z'; c++){
+                classes[static_cast<std::size_t>(c)] |= upper;
+            }
+            for(const char c : std::string_view{"\"'([{<`"}){
+                classes[static_cast<std::uint8_t>(c)] |= leading;
+            }
+            for(const char c : std::string_view{"\"')]}>`.,;:!?"}){
+                classes[static_cast<std::uint8_t>(c)] |= trailing;
+            }
+            for(std::size_t c{0x80}; c < 256; c++){
+                classes[c] |= non_ascii;
+            }
+            return classes;
+        }()};
+
+        std::uint8_t byte_class(const char c){
+            return byte_classes[static_cast<std::uint8_t>(c)];
+        }
+
+        // a code point that is not valid UTF-8.
+        constexpr char32_t invalid{0xFFFFFFFF};
+
+        /**
+         * @brief Decode the UTF-8 character starting at a position of a text.
+         *
+         * @return the length of the character in bytes, which is 1 for an invalid byte.
+         */
+        std::size_t decode(const std::string_view text, const std::size_t i, char32_t& code_point){
+            const auto byte{[&text](const std::size_t j){return static_cast<std::uint8_t>(text[j]);}};
+            const std::uint8_t first{byte(i)};
+
+            std::size_t length{0};
+            if(first < 0x80){
+                code_point = first;
+                return 1;
+            }
+            if((first & 0xE0) == 0xC0){
+                length = 2;
+                code_point = first & 0x1F;
+            }
+            else if((first & 0xF0) == 0xE0){
+                length = 3;
+                code_point = first & 0x0F;
+            }
+            else if((first & 0xF8) == 0xF0){
+                length = 4;
+                code_point = first & 0x07;
+            }
+
+            if(length == 0 || i + length > text.size()){
+                code_point = invalid;
+                return 1;
+            }
+            for(std::size_t j{i + 1}; j < i + length; j++){
+                if((byte(j) & 0xC0) != 0x80){
+                    code_point = invalid;
+                    return 1;
+                }
+                code_point = (code_point << 6) | (byte(j) & 0x3F);
+            }
+            return length;
+        }
+
+        // position of the start of the last character of a non-empty text.
+        std::size_t last_character(const std::string_view text){
+            std::size_t i{text.size() - 1};
+            while(i > 0 && text.size() - i < 4 && (static_cast<std::uint8_t>(text[i]) & 0xC0) == 0x80){
+                i--;
+            }
+            return i;
+        }
+
+        bool is_leading(const char32_t code_point){
+            return (code_point < 0x80 && (byte_classes[code_point] & leading)) ||
+                   code_point == U'‘' || code_point == U'“' || code_point == U'«' ||
+                   code_point == U'¿' || code_point == U'¡';
+        }
+
+        bool is_trailing(const char32_t code_point){
+            return (code_point < 0x80 && (byte_classes[code_point] & trailing)) ||
+                   code_point == U'’' || code_point == U'”' || code_point == U'»' ||
+                   code_point == U'…';
+        }
+
+        // the lower case of a letter, or the code point itself.
+        char32_t fold(const char32_t c){
+            if((c >= U'A' && c <= U'Z') || (c >= 0xC0 && c <= 0xDE && c != 0xD7) ||
+               (c >= 0x391 && c <= 0x3A9 && c != 0x3A2) || (c >= 0x410 && c <= 0x42F)){
+                return c + 32;
+            }
+            if(c >= 0x400 && c <= 0x40F){
+                return c + 80;
+            }
+            if(c == 0x178){
+                return 0xFF;
+            }
+            // Latin Extended-A pairs upper and lower case letters, the upper one first.
+            if((c >= 0x100 && c <= 0x137) || (c >= 0x14A && c <= 0x177)){
+                return c | 1;
+            }
+            if((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E)){
+                return c + (c & 1);
+            }
+            return c;
+        }
+
+        void encode(const char32_t c, std::string& out){
+            if(c < 0x80){
+                out.push_back(static_cast<char>(c));
+            }
+            else if(c < 0x800){
+                out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+                out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+            else if(c < 0x10000){
+                out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+            else{
+                out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+        }
+
+        // number of recently normalized words that are remembered.
+        constexpr std::size_t cache_size{1 << 12};
+    }
+
+    Normalizer::Normalizer(const bool fold_case, const bool strip_punctuation)
+        : _fold_case{fold_case}, _strip_punctuation{strip_punctuation}, _cache(helper::cache_size), _forms{},
+          _scratch{}
+        {}
+
+    /**
+     * @brief Get the normal form of a word.
+     *
+     * @param word: the word.
+     * @return the word itself if it is normal, otherwise a view of its normal form,
+     *         valid as long as the normalizer. The form is empty for a word of only punctuation.
+     */
+    std::string_view Normalizer::normalize(const std::string_view word){
+        if(word.empty()){
+            return word;
+        }
+
+        std::uint8_t classes{0};
+        for(const char c : word){
+            classes |= helper::byte_class(c);
+        }
+        const bool changes_case{_fold_case && (classes & (helper::upper | helper::non_ascii))};
+        const bool has_punctuation{_strip_punctuation &&
+                                   ((helper::byte_class(word.front()) & (helper::leading | helper::non_ascii)) ||
+                                    (helper::byte_class(word.back()) & (helper::trailing | helper::non_ascii)))};
+        if(!changes_case && !has_punctuation){
+            return word;
+        }
+
+        Entry& entry{_cache[Hash{}(word) % helper::cache_size]};
+        if(entry.word == word && entry.form.data() != nullptr){
+            return entry.form;
+        }
+
+        _transform(word, _scratch);
+        auto form{_forms.find(std::string_view{_scratch})};
+        if(form == _forms.end()){
+            form = _forms.emplace(_scratch).first;
+        }
+
+        entry.word.assign(word);
+        entry.form = *form;
+        return entry.form;
+    }
+
+    /**
+     * @brief Normalize all words of a text, in place, dropping words that become empty.
+     *
+     * @param text: a vector of words.
+     */
+    void Normalizer::apply(std::vector<std::string>& text){
+        auto out{text.begin()};
+        for(auto it{text.begin()}; it != text.end(); it++){
+            const std::string_view form{normalize(*it)};
+            if(form.empty()){
+                continue;
+            }
+            // the form is either the word itself or owned by the normalizer.
+            if(form.data() != it->data()){
+                out->assign(form);
+            }
+            else if(out != it){
+                *out = std::move(*it);
+            }
+            out++;
+        }
+        text.erase(out, text.end());
+    }
+
+    /**
+     * @brief Normalize all words of a text of views, in place, dropping words that become empty.
+     *
+     * Normalized words are views of forms owned by the normalizer, so it must outlive the text.
+     *
+     * @param text: a vector of views of words.
+     */
+    void Normalizer::apply(std::vector<std::string_view>& text){
+        auto out{text.begin()};
+        for(const std::string_view word : text){
+            if(const std::string_view form{normalize(word)}; !form.empty()){
+                *out++ = form;
+            }
+        }
+        text.erase(out, text.end());
+    }
+
+    /**
+     * @brief Create the frequency table of the normalized words of a text, from its table.
+     *
+     * Every distinct word is only normalized once, so this takes O(number of distinct
+     * words), and gives the same table as counting the normalized text.
+     *
+     * @param table: a table of words and their frequencies.
+     * @return the table of the normalized words.
+     */
+    FrequencyTable Normalizer::apply(const FrequencyTable& table){
+        FrequencyTable result{};
+        result.reserve(table.size());
+        for(const auto& [word, count] : table){
+            if(const std::string_view form{normalize(word)}; !form.empty()){
+                result.add(form, count);
+            }
+        }
+        return result;
+    }
+
+    // ------------------- PRIVATE FUNCTIONS -------------------
+
+    std::size_t Normalizer::Hash::operator()(const std::string_view word) const{
+        return std::hash<std::string_view>{}(word);
+    }
+
+    // write the normal form of a word.
+    void Normalizer::_transform(std::string_view word, std::string& out) const{
+        out.clear();
+
+        if(_strip_punctuation){
+            char32_t code_point{0};
+            while(!word.empty()){
+                const std::size_t length{helper::decode(word, 0, code_point)};
+                if(!helper::is_leading(code_point)){
+                    break;
+                }
+                word.remove_prefix(length);
+            }
+            while(!word.empty()){
+                const std::size_t last{helper::last_character(word)};
+                helper::decode(word, last, code_point);
+                if(!helper::is_trailing(code_point)){
+                    break;
+                }
+                word.remove_suffix(word.size() - last);
+            }
+        }
+
+        if(!_fold_case){
+            out.assign(word);
+            return;
+        }
+
+        out.reserve(word.size());
+        for(std::size_t i{0}; i < word.size();){
+            char32_t code_point{0};
+            const std::size_t length{helper::decode(word, i, code_point)};
+            const char32_t folded{code_point == helper::invalid ? code_point : helper::fold(code_point)};
+
+            if(folded == code_point){
+                out.append(word.substr(i, length));
+            }
+            else{
+                helper::encode(folded, out);
+            }
+            i += length;
+        }
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,58 @@
+/**
+ * normalizer.hpp
+ * --------------
+ * Description:
+ *   Header file containing declarations for normalizing words before they are counted.
+ * */
+
+#ifndef NORMALIZER_HPP
+#define NORMALIZER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "frequency_table.hpp"
+
+namespace editor {
+    class Normalizer{
+    public:
+        explicit Normalizer(bool fold_case = true, bool strip_punctuation = true);
+
+        std::string_view normalize(std::string_view word);
+
+        void apply(std::vector<std::string>& text);
+
+        void apply(std::vector<std::string_view>& text);
+
+        FrequencyTable apply(const FrequencyTable& table);
+
+    private:
+        struct Entry{
+            std::string word{};
+            std::string_view form{};
+        };
+
+        struct Hash{
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view word) const;
+        };
+
+        bool _fold_case;
+        bool _strip_punctuation;
+        // recently normalized words, at the position given by their hash.
+        std::vector<Entry> _cache;
+        // all distinct normalized forms, which never move.
+        std::unordered_set<std::string, Hash, std::equal_to<>> _forms;
+        std::string _scratch;
+
+        void _transform(std::string_view word, std::string& out) const;
+    };
+}
+
+#endif // NORMALIZER_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,65 @@
+#include "normalizer.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <string>
+
+TEST_CASE("Test editor::Normalizer normalizing words"){
+    editor::Normalizer normalizer{};
+
+    // normal words are returned as they are
+    const std::string word{"c++"};
+    REQUIRE(normalizer.normalize(word).data() == word.data());
+
+    REQUIRE(normalizer.normalize("The") == "the");
+    REQUIRE(normalizer.normalize("C++.") == "c++");
+    REQUIRE(normalizer.normalize("C#,") == "c#");
+    REQUIRE(normalizer.normalize("(\"Quoted!\")") == "quoted");
+    REQUIRE(normalizer.normalize("don't") == "don't");
+    REQUIRE(normalizer.normalize("e.g.") == "e.g");
+    REQUIRE(normalizer.normalize("--") == "--");
+    REQUIRE(normalizer.normalize("...") == "");
+    REQUIRE(normalizer.normalize("") == "");
+
+    // UTF-8 letters and punctuation
+    REQUIRE(normalizer.normalize("ÄPFEL") == "äpfel");
+    REQUIRE(normalizer.normalize("«Ελλάδα»") == "ελλάδα");
+    REQUIRE(normalizer.normalize("“МОСКВА…”") == "москва");
+    REQUIRE(normalizer.normalize("ŁÓDŹ") == "łódź");
+    REQUIRE(normalizer.normalize("ŸES") == "ÿes");
+    REQUIRE(normalizer.normalize("×") == "×");
+
+    // invalid UTF-8 is kept
+    const std::string invalid{"A\xff\xc3"};
+    REQUIRE(normalizer.normalize(invalid) == "a\xff\xc3");
+
+    // forms stay valid after the cache is overwritten
+    const std::string_view form{normalizer.normalize("Kept")};
+    for(int i{0}; i < 20000; i++){
+        normalizer.normalize("W" + std::to_string(i));
+    }
+    REQUIRE(form == "kept");
+    REQUIRE(normalizer.normalize("Kept").data() == form.data());
+
+    // each normalization can be chosen on its own
+    editor::Normalizer fold_only{true, false};
+    REQUIRE(fold_only.normalize("The.") == "the.");
+    editor::Normalizer strip_only{false, true};
+    REQUIRE(strip_only.normalize("The.") == "The");
+}
+
+TEST_CASE("Test editor::Normalizer normalizing texts and tables"){
+    const std::vector<std::string> text{"The", "cat", "and", "the", "hat.", "!", "THE", "Cat's", "(hat)"};
+    const std::vector<std::string> expected{"the", "cat", "and", "the", "hat", "the", "cat's", "hat"};
+
+    editor::Normalizer normalizer{};
+    std::vector<std::string> strings{text};
+    normalizer.apply(strings);
+    REQUIRE(strings == expected);
+
+    std::vector<std::string_view> views(text.begin(), text.end());
+    normalizer.apply(views);
+    REQUIRE(std::ranges::equal(views, expected));
+
+    // normalizing the table of a text is the same as counting the normalized text
+    REQUIRE(normalizer.apply(editor::create_frequency_table(text)) == editor::create_frequency_table(expected));
+}
@@ -0,0 +1,127 @@
+/**
+ * output_buffer.cpp
+ * -----------------
+ * Description:
+ *
+ *     ----- Output Buffer -----
+ *
+ *  Formats text, characters and numbers into one large buffer, which is written to
+ *  an output stream with a single `write` whenever it is full, and when the buffer
+ *  is destroyed. Numbers are formatted with `std::to_chars`, and padding is copied
+ *  from a line of spaces, so no formatting state of the stream is used.
+ *
+ *  The buffer is reused for all output, so printing a large text or table costs
+ *  one stream call per buffer instead of one or more per word.
+ *
+ **/
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include "output_buffer.hpp"
+
+namespace {
+    constexpr std::size_t spaces_size{64};
+    constexpr std::array<char, spaces_size> spaces{[]{
+        std::array<char, spaces_size> line{};
+        line.fill(' ');
+        return line;
+    }()};
+}
+
+namespace editor {
+    /**
+     * @brief Create a buffer for an output stream.
+     *
+     * @param os: the output stream, which must outlive the buffer.
+     * @param capacity: number of characters that are buffered before writing them.
+     */
+    OutputBuffer::OutputBuffer(std::ostream& os, const std::size_t capacity)
+        : _os{os}, _buffer(std::max<std::size_t>(capacity, std::numeric_limits<std::uint64_t>::digits10 + 1)), _size{0}
+        {}
+
+    // everything that is left in the buffer is written.
+    OutputBuffer::~OutputBuffer(){
+        flush();
+    }
+
+    /**
+     * @brief Add text to the buffer.
+     *
+     * Text that is larger than the buffer is written directly to the stream.
+     *
+     * @param text: the text.
+     */
+    void OutputBuffer::write(const std::string_view text){
+        if(text.size() > _buffer.size() - _size){
+            flush();
+
+            if(text.size() > _buffer.size()){
+                _os.write(text.data(), static_cast<std::streamsize>(text.size()));
+                return;
+            }
+        }
+
+        std::memcpy(_buffer.data() + _size, text.data(), text.size());
+        _size += text.size();
+    }
+
+    void OutputBuffer::write(const char c){
+        *_reserve(1) = c;
+        _size++;
+    }
+
+    /**
+     * @brief Add a number to the buffer, formatted in decimal.
+     *
+     * @param number: the number.
+     */
+    void OutputBuffer::write(const int number){
+        constexpr std::size_t max_digits{std::numeric_limits<int>::digits10 + 2};
+        char* begin{_reserve(max_digits)};
+        _size += static_cast<std::size_t>(std::to_chars(begin, begin + max_digits, number).ptr - begin);
+    }
+
+    void OutputBuffer::write(const std::uint64_t number){
+        constexpr std::size_t max_digits{std::numeric_limits<std::uint64_t>::digits10 + 1};
+        char* begin{_reserve(max_digits)};
+        _size += static_cast<std::size_t>(std::to_chars(begin, begin + max_digits, number).ptr - begin);
+    }
+
+    /**
+     * @brief Add spaces to the buffer.
+     *
+     * @param count: the number of spaces.
+     */
+    void OutputBuffer::pad(std::size_t count){
+        while(count > 0){
+            const std::size_t part{std::min(count, spaces_size)};
+            write(std::string_view{spaces.data(), part});
+            count -= part;
+        }
+    }
+
+    /**
+     * @brief Write the content of the buffer to the stream, and empty it.
+     *
+     * The stream itself is not flushed.
+     */
+    void OutputBuffer::flush(){
+        if(_size > 0){
+            _os.write(_buffer.data(), static_cast<std::streamsize>(_size));
+            _size = 0;
+        }
+    }
+
+    // the end of the buffer, after making room for at least `count` characters.
+    char* OutputBuffer::_reserve(const std::size_t count){
+        if(count > _buffer.size() - _size){
+            flush();
+        }
+        return _buffer.data() + _size;
+    }
+}
+
+// ============== END OF FILE ==============
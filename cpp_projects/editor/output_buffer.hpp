@@ -0,0 +1,50 @@
+/**
+ * output_buffer.hpp
+ * -----------------
+ * Description:
+ *   Header file containing declarations for buffered writing to output streams.
+ * */
+
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace editor {
+    class OutputBuffer{
+    public:
+        explicit OutputBuffer(std::ostream& os, std::size_t capacity = 1 << 16);
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        ~OutputBuffer();
+
+        void write(std::string_view text);
+
+        void write(char c);
+
+        void write(int number);
+
+        void write(std::uint64_t number);
+
+        void pad(std::size_t count);
+
+        void flush();
+
+    private:
+        std::ostream& _os;
+        std::vector<char> _buffer;
+        std::size_t _size;
+
+        char* _reserve(std::size_t count);
+    };
+}
+
+#endif // OUTPUT_BUFFER_HPP
+
+// ============== END OF FILE ==============
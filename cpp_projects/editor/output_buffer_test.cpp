@@ -0,0 +1,43 @@
+#include "output_buffer.hpp"
+#include "../../test/catch.hpp"
+#include <limits>
+#include <sstream>
+#include <string>
+
+TEST_CASE("Test editor::OutputBuffer class"){
+    std::ostringstream oss{};
+    {
+        editor::OutputBuffer output{oss};
+        output.write("word");
+        output.write(' ');
+        output.write(-42);
+        output.pad(3);
+        output.write(std::numeric_limits<int>::min());
+        output.write('\n');
+
+        // nothing is written before the buffer is flushed
+        REQUIRE(oss.str().empty());
+        output.flush();
+        REQUIRE(oss.str() == "word -42   " + std::to_string(std::numeric_limits<int>::min()) + "\n");
+        output.pad(0);
+        output.pad(150);
+    }
+    REQUIRE(oss.str().size() == 23 + 150);
+
+    // a small buffer, and text larger than the buffer
+    std::ostringstream oss1{};
+    std::string expected{};
+    {
+        editor::OutputBuffer output{oss1, 16};
+        for(int i{0}; i < 1000; i++){
+            output.write("w");
+            output.write(i);
+            output.pad(static_cast<std::size_t>(i % 3));
+            expected += "w" + std::to_string(i) + std::string(static_cast<std::size_t>(i % 3), ' ');
+        }
+        const std::string long_text(100, 'x');
+        output.write(long_text);
+        expected += long_text;
+    }
+    REQUIRE(oss1.str() == expected);
+}
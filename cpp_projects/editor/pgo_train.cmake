@@ -0,0 +1,20 @@
+# Training run for profile-guided optimization of the editor.
+# Generates a Zipf corpus with the benchmark, then runs the program on it in all modes
+# with the usual operations, discarding the output.
+# Expects BENCHMARK, APP and WORK_DIR to be defined, see CMakeLists.txt.
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+set(CORPUS ${WORK_DIR}/corpus.txt)
+
+execute_process(COMMAND ${BENCHMARK} --words=2000000 --corpus=${CORPUS} COMMAND_ERROR_IS_FATAL ANY)
+
+set(OPERATIONS --remove=a --substitute=b+c --table --frequency --top=100 --ngrams=2+100)
+foreach(MODE "" --mmap --normalize --stream=${WORK_DIR}/edited.txt)
+    execute_process(COMMAND ${APP} ${CORPUS} ${MODE} ${OPERATIONS} --print
+                    OUTPUT_QUIET COMMAND_ERROR_IS_FATAL ANY)
+endforeach()
+execute_process(COMMAND ${APP} ${CORPUS} --build-index=${WORK_DIR}/corpus.idx OUTPUT_QUIET COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${APP} ${WORK_DIR}/corpus.idx --index --positions=d --top=10
+                OUTPUT_QUIET COMMAND_ERROR_IS_FATAL ANY)
+
+file(REMOVE_RECURSE ${WORK_DIR})
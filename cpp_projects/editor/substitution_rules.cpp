@@ -0,0 +1,65 @@
+/**
+ * substitution_rules.cpp
+ * ----------------------
+ * Description:
+ *
+ *     ----- Substitution Rules -----
+ *
+ *  Reads a file of rules for substituting words, one rule per line:
+ *
+ *      <old> <new>
+ *
+ *  meaning that all occurrences of the word `old` are replaced with `new`. Empty
+ *  lines and lines starting with `#` are ignored. The rules are applied all at
+ *  once, so every word has at most one rule.
+ *
+ **/
+
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+#include "substitution_rules.hpp"
+
+namespace editor {
+    /**
+     * @brief Read substitution rules from a stream.
+     *
+     * @param is: an input stream with one rule per line.
+     * @return the rules, in order.
+     * @throws std::invalid_argument if a line cannot be parsed or a word has two rules.
+     */
+    SubstitutionRules read_substitution_rules(std::istream& is){
+        SubstitutionRules rules{};
+        std::unordered_set<std::string> old_words{};
+        std::string line{};
+        int line_number{0};
+
+        while(std::getline(is, line)){
+            line_number++;
+            std::istringstream iss{line};
+            std::string old_word{};
+            std::string new_word{};
+            std::string rest{};
+
+            if(!(iss >> old_word) || old_word.starts_with('#')){
+                continue;
+            }
+
+            if(!(iss >> new_word) || (iss >> rest)){
+                throw std::invalid_argument("Line " + std::to_string(line_number) + ": Expected `<old> <new>`.");
+            }
+
+            if(!old_words.insert(old_word).second){
+                throw std::invalid_argument("Line " + std::to_string(line_number) + ": Word `" + old_word +
+                                            "` already has a rule.");
+            }
+
+            rules.emplace_back(std::move(old_word), std::move(new_word));
+        }
+
+        return rules;
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,25 @@
+/**
+ * substitution_rules.hpp
+ * ----------------------
+ * Description:
+ *   Header file containing declarations for reading files of substitution rules.
+ * */
+
+#ifndef SUBSTITUTION_RULES_HPP
+#define SUBSTITUTION_RULES_HPP
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace editor {
+    // pairs of (old word, new word).
+    using SubstitutionRules = std::vector<std::pair<std::string, std::string>>;
+
+    SubstitutionRules read_substitution_rules(std::istream& is);
+}
+
+#endif // SUBSTITUTION_RULES_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,21 @@
+#include "substitution_rules.hpp"
+#include "../../test/catch.hpp"
+#include <sstream>
+
+TEST_CASE("Test editor::read_substitution_rules() function"){
+    std::istringstream iss{"# rules\n\nthe THE\n  a   b \n\tb a\n"};
+    const editor::SubstitutionRules rules{editor::read_substitution_rules(iss)};
+    REQUIRE(rules == editor::SubstitutionRules{{"the", "THE"}, {"a", "b"}, {"b", "a"}});
+
+    std::istringstream empty{""};
+    REQUIRE(editor::read_substitution_rules(empty).empty());
+
+    std::istringstream one_word{"the THE\nword\n"};
+    REQUIRE_THROWS_WITH(editor::read_substitution_rules(one_word), "Line 2: Expected `<old> <new>`.");
+
+    std::istringstream three_words{"a b c\n"};
+    REQUIRE_THROWS_WITH(editor::read_substitution_rules(three_words), "Line 1: Expected `<old> <new>`.");
+
+    std::istringstream twice{"a b\n\na c\n"};
+    REQUIRE_THROWS_WITH(editor::read_substitution_rules(twice), "Line 3: Word `a` already has a rule.");
+}
@@ -0,0 +1,128 @@
+/**
+ * tokenizer.cpp
+ * -------------
+ * Description:
+ *
+ *     ----- Tokenizer -----
+ *
+ *  Splits a text into words without copying it. A word is any sequence of
+ *  non-whitespace characters, the same as reading words with `operator>>`,
+ *  and every word is returned as a view into the original text.
+ *
+ *  The whitespace is found with AVX2 or SSE2 instructions when the compiler targets
+ *  them, comparing 32 or 16 characters at once, and one character at a time otherwise.
+ *
+ **/
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include "tokenizer.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr std::size_t block_size{64};
+
+    // whitespace as classified by std::isspace in the "C" locale.
+    constexpr bool is_space(const char c){
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    // bit i is set when character i of a full block is whitespace.
+    std::uint64_t space_mask(const char* block){
+#if defined(__AVX2__)
+        std::uint64_t mask{0};
+        for(std::size_t i{0}; i < block_size; i += 32){
+            const __m256i chars{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i))};
+            // '\t' to '\r' are the characters 9 to 13, so c - 9 is at most 4 when unsigned.
+            const __m256i shifted{_mm256_sub_epi8(chars, _mm256_set1_epi8(9))};
+            const __m256i is_control{_mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted)};
+            const __m256i is_blank{_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '))};
+            const auto bits{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_control, is_blank)))};
+            mask |= std::uint64_t{bits} << i;
+        }
+        return mask;
+#elif defined(__SSE2__)
+        std::uint64_t mask{0};
+        for(std::size_t i{0}; i < block_size; i += 16){
+            const __m128i chars{_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i))};
+            // '\t' to '\r' are the characters 9 to 13, so c - 9 is at most 4 when unsigned.
+            const __m128i shifted{_mm_sub_epi8(chars, _mm_set1_epi8(9))};
+            const __m128i is_control{_mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted)};
+            const __m128i is_blank{_mm_cmpeq_epi8(chars, _mm_set1_epi8(' '))};
+            const auto bits{static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(is_control, is_blank)))};
+            mask |= std::uint64_t{bits} << i;
+        }
+        return mask;
+#else
+        std::uint64_t mask{0};
+        for(std::size_t i{0}; i < block_size; i++){
+            mask |= std::uint64_t{is_space(block[i])} << i;
+        }
+        return mask;
+#endif
+    }
+
+    // same as space_mask for the last, partial block, where the missing characters count as whitespace.
+    std::uint64_t tail_space_mask(const char* block, const std::size_t size){
+        std::uint64_t mask{~std::uint64_t{0} << size};
+        for(std::size_t i{0}; i < size; i++){
+            mask |= std::uint64_t{is_space(block[i])} << i;
+        }
+        return mask;
+    }
+}
+
+namespace editor {
+    /**
+     * @brief Split a text into words.
+     *
+     * The text is scanned 64 characters at a time: a bit mask of the whitespace in
+     * each block is built with SIMD instructions when they are available, and the
+     * beginnings and ends of words are the bits where the mask changes.
+     *
+     * @param text: a text, which must outlive the returned words.
+     * @return vector of views of the words, in order.
+     */
+    std::vector<std::string_view> split_words(const std::string_view text){
+        std::vector<std::string_view> words{};
+        const char* data{text.data()};
+        std::size_t word_begin{0};
+        // whether the character before the current block is part of a word.
+        std::uint64_t in_word{0};
+
+        for(std::size_t pos{0}; pos < text.size(); pos += block_size){
+            const std::size_t size{std::min(block_size, text.size() - pos)};
+            const std::uint64_t words_mask{~(size == block_size ? space_mask(data + pos)
+                                                                : tail_space_mask(data + pos, size))};
+
+            // the bits where a word begins or ends, which alternate.
+            std::uint64_t boundaries{words_mask ^ ((words_mask << 1) | in_word)};
+            in_word = words_mask >> (block_size - 1);
+
+            for(; boundaries != 0; boundaries &= boundaries - 1){
+                const auto bit{static_cast<std::size_t>(std::countr_zero(boundaries))};
+
+                if((words_mask >> bit & 1) != 0){
+                    word_begin = pos + bit;
+                }
+                else{
+                    words.emplace_back(data + word_begin, pos + bit - word_begin);
+                }
+            }
+        }
+
+        if(in_word != 0){
+            words.emplace_back(data + word_begin, text.size() - word_begin);
+        }
+
+        return words;
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,20 @@
+/**
+ * tokenizer.hpp
+ * -------------
+ * Description:
+ *   Header file containing declarations for splitting text into words.
+ * */
+
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <string_view>
+#include <vector>
+
+namespace editor {
+    std::vector<std::string_view> split_words(std::string_view text);
+}
+
+#endif // TOKENIZER_HPP
+
+// ============== END OF FILE ==============
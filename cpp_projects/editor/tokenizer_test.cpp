@@ -0,0 +1,95 @@
+#include "tokenizer.hpp"
+#include "mapped_file.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+// -------------- UNIT TESTS --------------
+
+TEST_CASE("Test editor::split_words() function"){
+    // empty text and only whitespace
+    REQUIRE(editor::split_words("").empty());
+    REQUIRE(editor::split_words(" \t\n\v\f\r ").empty());
+
+    // words separated by any whitespace, punctuation belongs to the words
+    const std::vector<std::string_view> words{editor::split_words("  C++ is\tvery\npowerful. \r\n")};
+    REQUIRE(words == std::vector<std::string_view>{"C++", "is", "very", "powerful."});
+
+    // same words as reading with operator>>
+    const std::string content{"Programming is fun Especially when you get to use the STL which stands for the "
+                              "Standard Template Library.\n\tC++ is very powerful.  C++ has amazing features.\n"};
+    std::istringstream iss{content};
+    const std::vector<std::string> expected{std::istream_iterator<std::string>{iss}, {}};
+    const std::vector<std::string_view> tokens{editor::split_words(content)};
+    REQUIRE(std::ranges::equal(tokens, expected));
+}
+
+TEST_CASE("Test editor::MappedFile class"){
+    const std::filesystem::path path{std::filesystem::temp_directory_path() / "mapped_file_test.txt"};
+
+    {
+        std::ofstream file{path};
+        file << "first second\nfirst";
+    }
+    {
+        const editor::MappedFile file{path.string()};
+        REQUIRE(file.view() == "first second\nfirst");
+    }
+
+    // empty file
+    {
+        std::ofstream file{path};
+    }
+    const editor::MappedFile empty{path.string()};
+    REQUIRE(empty.view().empty());
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_WITH(editor::MappedFile{path.string()}, "File `" + path.string() + "` not found.");
+}
+
+TEST_CASE("Test editor functions on views of words"){
+    const std::string text{"w1 w2 w1 w3"};
+    const std::vector<std::string_view> words{editor::split_words(text)};
+
+    editor::FrequencyTable table{editor::create_frequency_table(words)};
+    REQUIRE(table.size() == 3);
+    REQUIRE(table.at("w1") == 2);
+
+    std::ostringstream oss{};
+    editor::print_text(words, oss);
+    REQUIRE(oss.str() == "w1 w2 w1 w3 \n");
+
+    const std::vector<std::string_view> removed{editor::remove_word(words, "w1")};
+    REQUIRE(removed == std::vector<std::string_view>{"w2", "w3"});
+    REQUIRE(words.size() == 4);
+
+    const std::vector<std::string_view> substituted{editor::substitute_word(words, "w1", "word")};
+    REQUIRE(substituted == std::vector<std::string_view>{"word", "w2", "word", "w3"});
+    REQUIRE(words.at(0) == "w1");
+}
+
+// ============== END OF FILE ==============
+
+TEST_CASE("Test editor::split_words() function on random texts"){
+    // all whitespace characters, and characters that are close to them
+    const std::string alphabet{" \t\n\v\f\r\x08\x0e\x1f!~\x7f\x80\xff" "ab"};
+    std::uint32_t state{12345};
+    const auto random{[&state](const std::size_t n){
+        state = state * 1664525 + 1013904223;
+        return (state >> 8) % n;
+    }};
+
+    for(std::size_t length{0}; length < 300; length++){
+        std::string content{};
+        for(std::size_t i{0}; i < length; i++){
+            content += alphabet[random(alphabet.size())];
+        }
+
+        std::istringstream iss{content};
+        const std::vector<std::string> expected{std::istream_iterator<std::string>{iss}, {}};
+        REQUIRE(std::ranges::equal(editor::split_words(content), expected));
+    }
+}
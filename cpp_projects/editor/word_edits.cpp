@@ -0,0 +1,241 @@
+/**
+ * word_edits.cpp
+ * --------------
+ * Description:
+ *
+ *     ----- Word Edits -----
+ *
+ *  A sequence of removals and substitutions of whole words, combined into a single
+ *  mapping from each edited word to the word it finally becomes, or to nothing if it
+ *  is removed. Words that are not in the mapping are left as they are.
+ *
+ *  Adding an edit only updates the mapping, so any number of edits is applied to a
+ *  text in one pass over it, and to a frequency table as a delta of the counts of
+ *  the edited words only, without counting the text again.
+ *
+ *  The edits own all words they refer to, and keep them until they are destroyed,
+ *  so views of substituted words stay valid after the edits are cleared.
+ *
+ **/
+
+#include <algorithm>
+#include <utility>
+#include "word_edits.hpp"
+
+namespace editor {
+    WordEdits::WordEdits()
+        : _edits{}, _words{}
+        {}
+
+    /**
+     * @brief Add the removal of all occurrences of a word.
+     *
+     * @param word: the word to remove.
+     */
+    void WordEdits::remove(const std::string_view word){
+        for(auto& [edited, result] : _edits){
+            if(result == word){
+                result.reset();
+            }
+        }
+
+        // a word that is already edited does not occur in the text anymore.
+        if(!_edits.contains(word)){
+            _edits.emplace(_own(word), std::nullopt);
+        }
+    }
+
+    /**
+     * @brief Add the removals of many words at once.
+     *
+     * Adding the removals takes O(number of edits + number of words), like adding
+     * many substitutions at once.
+     *
+     * @param words: the words to remove.
+     */
+    void WordEdits::remove(const std::vector<std::string_view>& words){
+        const std::unordered_set<std::string_view> removed(words.begin(), words.end());
+
+        for(auto& [edited, result] : _edits){
+            if(result && removed.contains(*result)){
+                result.reset();
+            }
+        }
+
+        _edits.reserve(_edits.size() + removed.size());
+        for(const std::string_view word : removed){
+            if(!_edits.contains(word)){
+                _edits.emplace(_own(word), std::nullopt);
+            }
+        }
+    }
+
+    /**
+     * @brief Add the substitution of all occurrences of a word with another word.
+     *
+     * @param old_word: the word to be replaced.
+     * @param new_word: the word to replace old word with.
+     */
+    void WordEdits::substitute(const std::string_view old_word, const std::string_view new_word){
+        if(old_word == new_word){
+            return;
+        }
+
+        const std::string_view owned{_own(new_word)};
+        for(auto& [edited, result] : _edits){
+            if(result == old_word){
+                result = owned;
+            }
+        }
+
+        if(!_edits.contains(old_word)){
+            _edits.emplace(_own(old_word), owned);
+        }
+    }
+
+    /**
+     * @brief Add the substitutions of many words at once.
+     *
+     * Every word is replaced at most once, by its own rule, so rules may swap words.
+     * Adding the rules takes O(number of edits + number of rules), and applying the
+     * edits afterwards still takes a single lookup per word.
+     *
+     * @param rules: pairs of (old word, new word), with at most one rule per old word.
+     */
+    void WordEdits::substitute(const SubstitutionRules& rules){
+        std::unordered_map<std::string_view, std::string_view> mapping{};
+        mapping.reserve(rules.size());
+        for(const auto& [old_word, new_word] : rules){
+            if(old_word != new_word){
+                mapping.emplace(old_word, new_word);
+            }
+        }
+
+        // the words that edited words have become are replaced first, so that no word is replaced twice.
+        for(auto& [edited, result] : _edits){
+            if(result){
+                if(const auto rule{mapping.find(*result)}; rule != mapping.end()){
+                    result = _own(rule->second);
+                }
+            }
+        }
+
+        _edits.reserve(_edits.size() + mapping.size());
+        for(const auto& [old_word, new_word] : mapping){
+            if(!_edits.contains(old_word)){
+                _edits.emplace(_own(old_word), _own(new_word));
+            }
+        }
+    }
+
+    bool WordEdits::empty() const{
+        return _edits.empty();
+    }
+
+    // forget all edits, but keep the words they refer to.
+    void WordEdits::clear(){
+        _edits.clear();
+    }
+
+    /**
+     * @brief Apply the edits to a text, in place and in one pass.
+     *
+     * @param text: a vector of words.
+     */
+    void WordEdits::apply(std::vector<std::string>& text) const{
+        if(_edits.empty()){
+            return;
+        }
+
+        auto out{text.begin()};
+        for(auto it{text.begin()}; it != text.end(); it++){
+            const auto edit{_edits.find(*it)};
+
+            if(edit == _edits.end()){
+                if(out != it){
+                    *out = std::move(*it);
+                }
+                out++;
+            }
+            else if(edit->second){
+                out->assign(*edit->second);
+                out++;
+            }
+        }
+
+        text.erase(out, text.end());
+    }
+
+    /**
+     * @brief Apply the edits to a text of views, in place and in one pass.
+     *
+     * Substituted words are views of the words owned by the edits, so the edits must
+     * outlive the text.
+     *
+     * @param text: a vector of views of words.
+     */
+    void WordEdits::apply(std::vector<std::string_view>& text) const{
+        if(_edits.empty()){
+            return;
+        }
+
+        auto out{text.begin()};
+        for(const std::string_view word : text){
+            const auto edit{_edits.find(word)};
+
+            if(edit == _edits.end()){
+                *out++ = word;
+            }
+            else if(edit->second){
+                *out++ = *edit->second;
+            }
+        }
+
+        text.erase(out, text.end());
+    }
+
+    /**
+     * @brief Create the change of a frequency table of a text made by the edits.
+     *
+     * Only the edited words that are in the table are looked at, so this takes
+     * O(number of edits). The delta refers to words owned by the edits.
+     *
+     * @param table: a table of words and their frequencies.
+     * @return the change of frequencies.
+     */
+    FrequencyDelta WordEdits::delta(const FrequencyTable& table) const{
+        FrequencyDelta delta{};
+
+        for(const auto& [edited, result] : _edits){
+            if(!table.contains(edited)){
+                continue;
+            }
+
+            const int count{table.at(edited)};
+            delta.emplace_back(edited, -count);
+            if(result){
+                delta.emplace_back(*result, count);
+            }
+        }
+
+        return delta;
+    }
+
+    /**
+     * @brief Apply the edits to a frequency table of a text.
+     *
+     * The table becomes the frequency table of the edited text, without counting it again.
+     *
+     * @param table: a table of words and their frequencies.
+     */
+    void WordEdits::apply(FrequencyTable& table) const{
+        table.apply(delta(table));
+    }
+
+    // keep a copy of a word that lives as long as the edits.
+    std::string_view WordEdits::_own(const std::string_view word){
+        return _words.emplace_back(word);
+    }
+}
+
+// ============== END OF FILE ==============
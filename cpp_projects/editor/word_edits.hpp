@@ -0,0 +1,57 @@
+/**
+ * word_edits.hpp
+ * --------------
+ * Description:
+ *   Header file containing declarations for combined removals and substitutions of words.
+ * */
+
+#ifndef WORD_EDITS_HPP
+#define WORD_EDITS_HPP
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "frequency_table.hpp"
+#include "substitution_rules.hpp"
+
+namespace editor {
+    class WordEdits{
+    public:
+        WordEdits();
+
+        void remove(std::string_view word);
+
+        void remove(const std::vector<std::string_view>& words);
+
+        void substitute(std::string_view old_word, std::string_view new_word);
+
+        void substitute(const SubstitutionRules& rules);
+
+        bool empty() const;
+
+        void clear();
+
+        void apply(std::vector<std::string>& text) const;
+
+        void apply(std::vector<std::string_view>& text) const;
+
+        FrequencyDelta delta(const FrequencyTable& table) const;
+
+        void apply(FrequencyTable& table) const;
+
+    private:
+        // edited words, mapped to the word they become, or to nothing when removed.
+        std::unordered_map<std::string_view, std::optional<std::string_view>> _edits;
+        std::deque<std::string> _words;
+
+        std::string_view _own(std::string_view word);
+    };
+}
+
+#endif // WORD_EDITS_HPP
+
+// ============== END OF FILE ==============
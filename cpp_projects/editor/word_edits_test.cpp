@@ -0,0 +1,98 @@
+#include "word_edits.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <string>
+
+TEST_CASE("Test editor::WordEdits combining edits"){
+    std::vector<std::string> text{"a", "b", "c", "a", "d", "b", "e"};
+
+    editor::WordEdits edits{};
+    REQUIRE(edits.empty());
+    edits.substitute("a", "b");     // b b c b d b e
+    edits.remove("b");              // c d e
+    edits.substitute("c", "d");     // d d e
+    edits.substitute("d", "a");     // a a e
+    edits.substitute("e", "e");
+    REQUIRE_FALSE(edits.empty());
+
+    edits.apply(text);
+    REQUIRE(text == std::vector<std::string>{"a", "a", "e"});
+
+    edits.clear();
+    REQUIRE(edits.empty());
+    edits.apply(text);
+    REQUIRE(text == std::vector<std::string>{"a", "a", "e"});
+}
+
+TEST_CASE("Test editor::WordEdits against one edit at a time"){
+    std::vector<std::string> text{};
+    for(int i{0}; i < 3000; i++){
+        text.push_back("w" + std::to_string(i * 31 % 17));
+    }
+    const std::vector<std::string_view> views(text.begin(), text.end());
+
+    std::vector<std::string> expected{text};
+    editor::WordEdits edits{};
+    for(int i{0}; i < 40; i++){
+        const std::string word{"w" + std::to_string(i * 7 % 19)};
+        const std::string other{"w" + std::to_string(i * 5 % 23)};
+
+        if(i % 3 == 0){
+            expected = editor::remove_word(std::move(expected), word);
+            edits.remove(word);
+        }
+        else{
+            expected = editor::substitute_word(std::move(expected), word, other);
+            edits.substitute(word, other);
+        }
+    }
+
+    std::vector<std::string> edited{text};
+    edits.apply(edited);
+    REQUIRE(edited == expected);
+
+    std::vector<std::string_view> edited_views{views};
+    edits.apply(edited_views);
+    REQUIRE(std::ranges::equal(edited_views, expected));
+
+    editor::FrequencyTable table{editor::create_frequency_table(text)};
+    edits.apply(table);
+    REQUIRE(table == editor::create_frequency_table(expected));
+}
+
+TEST_CASE("Test editor::WordEdits substituting many words at once"){
+    std::vector<std::string> text{"a", "b", "c", "d", "a", "e"};
+
+    editor::WordEdits edits{};
+    edits.remove("e");
+    edits.substitute("d", "a");     // a b c a a
+    // a and b are swapped, and e is already removed: b a c b b
+    edits.substitute(editor::SubstitutionRules{{"a", "b"}, {"b", "a"}, {"c", "c"}, {"e", "x"}});
+
+    std::vector<std::string> edited{text};
+    edits.apply(edited);
+    REQUIRE(edited == std::vector<std::string>{"b", "a", "c", "b", "b"});
+
+    editor::FrequencyTable table{editor::create_frequency_table(text)};
+    edits.apply(table);
+    REQUIRE(table == editor::create_frequency_table(edited));
+
+    // many removals at once, of words that other words have become
+    editor::WordEdits removals{};
+    removals.substitute("a", "x");
+    removals.remove(std::vector<std::string_view>{"x", "b", "c", "b"});
+    std::vector<std::string> removed{text};
+    removals.apply(removed);
+    REQUIRE(removed == std::vector<std::string>{"d", "e"});
+
+    // many rules
+    editor::SubstitutionRules rules{};
+    for(int i{0}; i < 10000; i++){
+        rules.emplace_back("w" + std::to_string(i), "w" + std::to_string(i + 1));
+    }
+    editor::WordEdits shift{};
+    shift.substitute(rules);
+    std::vector<std::string> words{"w0", "w5000", "w9999", "w10000"};
+    shift.apply(words);
+    REQUIRE(words == std::vector<std::string>{"w1", "w5001", "w10000", "w10000"});
+}
@@ -0,0 +1,289 @@
+/**
+ * word_index.cpp
+ * --------------
+ * Description:
+ *
+ *     ----- Word Index -----
+ *
+ *  An index of the words of a text, written to a file once and then memory-mapped by
+ *  every run that queries it, so that no run has to read and count the text again.
+ *
+ *  The index holds the vocabulary of the text, sorted, and for every word the list
+ *  of its positions in the text, i.e. the numbers of the words that are equal to it.
+ *  The frequency of a word is the length of its list. The file is a fixed header
+ *  followed by arrays of 8-byte integers, and is read in place without any parsing:
+ *
+ *  | "WORDIDX1" | number of words | vocabulary size | names size |      (4 x 8 bytes)
+ *  | name offsets (vocabulary size + 1) | position offsets (vocabulary size + 1) |
+ *  | positions (number of words) | names, one after the other |
+ *
+ *  Words are looked up by a binary search over the sorted vocabulary.
+ *
+ **/
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "word_index.hpp"
+
+namespace {
+    constexpr std::array<char, 8> magic{'W', 'O', 'R', 'D', 'I', 'D', 'X', '1'};
+
+    struct IndexHeader{
+        std::array<char, 8> magic;
+        std::uint64_t num_words;
+        std::uint64_t vocabulary_size;
+        std::uint64_t names_size;
+    };
+
+    // total size of an index file with the given header.
+    std::uint64_t file_size(const IndexHeader& header){
+        return sizeof(IndexHeader) + (2 * (header.vocabulary_size + 1) + header.num_words) * sizeof(std::uint64_t) +
+               header.names_size;
+    }
+
+    template<typename T>
+    void write_array(std::ofstream& file, const std::vector<T>& array){
+        file.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(T)));
+    }
+
+    // write the index of the words of a text, with the vocabulary in sorted order.
+    template<typename Word>
+    void write_index(const std::vector<Word>& text_vector, const std::string& path){
+        std::vector<std::string_view> vocabulary{};
+        std::unordered_map<std::string_view, std::uint64_t> ids{};
+        for(const Word& word : text_vector){
+            if(ids.emplace(word, 0).second){
+                vocabulary.emplace_back(word);
+            }
+        }
+        std::ranges::sort(vocabulary);
+
+        std::vector<std::uint64_t> name_offsets{0};
+        for(std::uint64_t id{0}; id < vocabulary.size(); id++){
+            ids[vocabulary[id]] = id;
+            name_offsets.push_back(name_offsets.back() + vocabulary[id].size());
+        }
+
+        // the positions are grouped by word with a counting sort.
+        std::vector<std::uint64_t> word_ids(text_vector.size());
+        std::vector<std::uint64_t> position_offsets(vocabulary.size() + 1);
+        for(std::size_t i{0}; i < text_vector.size(); i++){
+            word_ids[i] = ids.at(text_vector[i]);
+            position_offsets[word_ids[i] + 1]++;
+        }
+        for(std::size_t id{0}; id < vocabulary.size(); id++){
+            position_offsets[id + 1] += position_offsets[id];
+        }
+
+        std::vector<std::uint64_t> positions(text_vector.size());
+        std::vector<std::uint64_t> next{position_offsets.begin(), position_offsets.end() - 1};
+        for(std::size_t i{0}; i < text_vector.size(); i++){
+            positions[next[word_ids[i]]++] = i;
+        }
+
+        const IndexHeader header{magic, text_vector.size(), vocabulary.size(), name_offsets.back()};
+        std::ofstream file{path, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_array(file, name_offsets);
+        write_array(file, position_offsets);
+        write_array(file, positions);
+        for(const std::string_view word : vocabulary){
+            file.write(word.data(), static_cast<std::streamsize>(word.size()));
+        }
+
+        if(!file){
+            throw std::runtime_error("Cannot write index `" + path + "`.");
+        }
+    }
+}
+
+namespace editor {
+    /**
+     * @brief Write the index of the words of a text to a file.
+     *
+     * @param text_vector: constant reference to a vector of words.
+     * @param path: path of the index file.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write_word_index(const std::vector<std::string>& text_vector, const std::string& path){
+        write_index(text_vector, path);
+    }
+
+    /**
+     * @brief Write the index of the words of a text of views to a file.
+     *
+     * @param text_vector: constant reference to a vector of views of words.
+     * @param path: path of the index file.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write_word_index(const std::vector<std::string_view>& text_vector, const std::string& path){
+        write_index(text_vector, path);
+    }
+
+    /**
+     * @brief Open an index file.
+     *
+     * The file is memory-mapped and only its header and offsets are read. The offsets
+     * of the names and of the positions of the words must start at zero and never
+     * decrease up to the end of the array they point into, so that no query of the
+     * index reads outside of the file, which is checked once in O(vocabulary size).
+     *
+     * @param path: path of the index file.
+     * @throws std::runtime_error if the file cannot be read or is not a valid index.
+     */
+    WordIndex::WordIndex(const std::string& path)
+        : _file{path}, _num_words{0}, _size{0}
+    {
+        const std::string_view data{_file.view()};
+        IndexHeader header{};
+
+        if(data.size() >= sizeof(header)){
+            std::memcpy(&header, data.data(), sizeof(header));
+        }
+
+        // sizes larger than the file could make its computed size wrap around.
+        const std::uint64_t max_count{data.size() / sizeof(std::uint64_t)};
+        if(data.size() < sizeof(header) || header.magic != magic || header.num_words > max_count ||
+           header.vocabulary_size > max_count || header.names_size > data.size() || data.size() != file_size(header)){
+            throw std::runtime_error("Invalid index `" + path + "`.");
+        }
+
+        _num_words = header.num_words;
+        _size = header.vocabulary_size;
+
+        if(_name_offset(0) != 0 || _position_offset(0) != 0 || _name_offset(_size) != header.names_size ||
+           _position_offset(_size) != _num_words){
+            throw std::runtime_error("Invalid index `" + path + "`.");
+        }
+
+        for(std::size_t id{0}; id < _size; id++){
+            if(_name_offset(id + 1) < _name_offset(id) || _position_offset(id + 1) < _position_offset(id)){
+                throw std::runtime_error("Invalid index `" + path + "`.");
+            }
+        }
+    }
+
+    // number of words of the text.
+    std::uint64_t WordIndex::num_words() const{
+        return _num_words;
+    }
+
+    // number of distinct words of the text.
+    std::size_t WordIndex::size() const{
+        return _size;
+    }
+
+    /**
+     * @brief Get a word of the vocabulary.
+     *
+     * @param id: position of the word in the sorted vocabulary.
+     * @return view of the word, valid for as long as the index lives.
+     * @throws std::out_of_range if there is no word at that position.
+     */
+    std::string_view WordIndex::word(const std::size_t id) const{
+        _check(id);
+        const std::size_t names_begin{sizeof(IndexHeader) + (2 * (_size + 1) + _num_words) * sizeof(std::uint64_t)};
+        const std::uint64_t begin{_name_offset(id)};
+        return _file.view().substr(names_begin + begin, _name_offset(id + 1) - begin);
+    }
+
+    /**
+     * @brief Get the frequency of a word of the vocabulary.
+     *
+     * @param id: position of the word in the sorted vocabulary.
+     * @return the number of its positions.
+     * @throws std::out_of_range if there is no word at that position.
+     */
+    int WordIndex::frequency(const std::size_t id) const{
+        _check(id);
+        return static_cast<int>(_position_offset(id + 1) - _position_offset(id));
+    }
+
+    /**
+     * @brief Get the positions of a word in the text.
+     *
+     * @param id: position of the word in the sorted vocabulary.
+     * @return the numbers of the words of the text that are equal to it, in increasing order.
+     * @throws std::out_of_range if there is no word at that position.
+     */
+    std::vector<std::uint64_t> WordIndex::positions(const std::size_t id) const{
+        _check(id);
+        const std::size_t positions_begin{sizeof(IndexHeader) + 2 * (_size + 1) * sizeof(std::uint64_t)};
+        std::vector<std::uint64_t> word_positions(_position_offset(id + 1) - _position_offset(id));
+
+        std::memcpy(word_positions.data(),
+                    _file.view().data() + positions_begin + _position_offset(id) * sizeof(std::uint64_t),
+                    word_positions.size() * sizeof(std::uint64_t));
+
+        return word_positions;
+    }
+
+    /**
+     * @brief Find a word in the vocabulary, with a binary search.
+     *
+     * @param word: the word.
+     * @return position of the word in the sorted vocabulary, or nothing if it is not in the text.
+     */
+    std::optional<std::size_t> WordIndex::find(const std::string_view word) const{
+        std::size_t low{0};
+        std::size_t high{_size};
+
+        while(low < high){
+            const std::size_t middle{low + (high - low) / 2};
+            if(this->word(middle) < word){
+                low = middle + 1;
+            }
+            else{
+                high = middle;
+            }
+        }
+
+        if(low < _size && this->word(low) == word){
+            return low;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Create the frequency table of the text.
+     *
+     * @return a table of all words of the text and their frequencies.
+     */
+    FrequencyTable WordIndex::frequency_table() const{
+        FrequencyTable table{};
+        table.reserve(_size);
+
+        for(std::size_t id{0}; id < _size; id++){
+            table.add(word(id), frequency(id));
+        }
+
+        return table;
+    }
+
+    void WordIndex::_check(const std::size_t id) const{
+        if(id >= _size){
+            throw std::out_of_range("No word at position " + std::to_string(id) + " of the index.");
+        }
+    }
+
+    // 8-byte integer at an offset of the file.
+    std::uint64_t WordIndex::_read(const std::size_t offset) const{
+        std::uint64_t value{};
+        std::memcpy(&value, _file.view().data() + offset, sizeof(value));
+        return value;
+    }
+
+    std::uint64_t WordIndex::_name_offset(const std::size_t id) const{
+        return _read(sizeof(IndexHeader) + id * sizeof(std::uint64_t));
+    }
+
+    std::uint64_t WordIndex::_position_offset(const std::size_t id) const{
+        return _read(sizeof(IndexHeader) + (_size + 1 + id) * sizeof(std::uint64_t));
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,57 @@
+/**
+ * word_index.hpp
+ * --------------
+ * Description:
+ *   Header file containing declarations for the on-disk index of the words of a text.
+ * */
+
+#ifndef WORD_INDEX_HPP
+#define WORD_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "frequency_table.hpp"
+#include "mapped_file.hpp"
+
+namespace editor {
+    void write_word_index(const std::vector<std::string>& text_vector, const std::string& path);
+
+    void write_word_index(const std::vector<std::string_view>& text_vector, const std::string& path);
+
+    class WordIndex{
+    public:
+        explicit WordIndex(const std::string& path);
+
+        std::uint64_t num_words() const;
+
+        std::size_t size() const;
+
+        std::string_view word(std::size_t id) const;
+
+        int frequency(std::size_t id) const;
+
+        std::vector<std::uint64_t> positions(std::size_t id) const;
+
+        std::optional<std::size_t> find(std::string_view word) const;
+
+        FrequencyTable frequency_table() const;
+
+    private:
+        MappedFile _file;
+        std::uint64_t _num_words;
+        std::size_t _size;
+
+        void _check(std::size_t id) const;
+        std::uint64_t _read(std::size_t offset) const;
+        std::uint64_t _name_offset(std::size_t id) const;
+        std::uint64_t _position_offset(std::size_t id) const;
+    };
+}
+
+#endif // WORD_INDEX_HPP
+
+// ============== END OF FILE ==============
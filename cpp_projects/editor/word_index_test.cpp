@@ -0,0 +1,75 @@
+#include "word_index.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+TEST_CASE("Test editor::WordIndex class"){
+    const std::filesystem::path path{std::filesystem::temp_directory_path() / "word_index_test.idx"};
+    const std::vector<std::string> text{"the", "cat", "and", "the", "hat", "", "the", "end"};
+
+    editor::write_word_index(text, path.string());
+    {
+        const editor::WordIndex index{path.string()};
+        REQUIRE(index.num_words() == text.size());
+        REQUIRE(index.size() == 6);
+
+        // the vocabulary is sorted
+        REQUIRE(index.word(0) == "");
+        REQUIRE(index.word(5) == "the");
+        REQUIRE(index.find("the") == 5);
+        REQUIRE(index.find("cat") == 2);
+        REQUIRE_FALSE(index.find("dog"));
+        REQUIRE_FALSE(index.find("zzz"));
+
+        REQUIRE(index.frequency(5) == 3);
+        REQUIRE(index.positions(5) == std::vector<std::uint64_t>{0, 3, 6});
+        REQUIRE(index.positions(*index.find("end")) == std::vector<std::uint64_t>{7});
+        REQUIRE_THROWS_WITH(index.word(6), "No word at position 6 of the index.");
+
+        REQUIRE(index.frequency_table() == editor::create_frequency_table(text));
+    }
+
+    // views of words give the same index
+    const std::vector<std::string_view> views(text.begin(), text.end());
+    editor::write_word_index(views, path.string());
+    REQUIRE(editor::WordIndex{path.string()}.frequency_table() == editor::create_frequency_table(text));
+
+    // empty text
+    editor::write_word_index(std::vector<std::string>{}, path.string());
+    REQUIRE(editor::WordIndex{path.string()}.size() == 0);
+
+    // offsets that go backwards or past the end of the file
+    const auto corrupt{[&path](const std::size_t offset, const std::uint64_t value){
+        editor::write_word_index(std::vector<std::string>{"the", "cat", "and", "the", "hat"}, path.string());
+        std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }};
+    // a header of 4 x 8 bytes, then 5 offsets of the names and 5 offsets of the positions of 8 bytes each
+    for(const auto& [offset, value] : std::vector<std::pair<std::size_t, std::uint64_t>>{
+            {32 + 8 * 1, 7}, {32 + 8 * 2, 1}, {32 + 8 * 5, 1}, {32 + 8 * 6, 6}, {32 + 8 * 7, 1000000}}){
+        corrupt(offset, value);
+        REQUIRE_THROWS_WITH(editor::WordIndex{path.string()}, "Invalid index `" + path.string() + "`.");
+    }
+
+    // not an index
+    {
+        std::ofstream file{path};
+        file << "the cat and the hat";
+    }
+    REQUIRE_THROWS_WITH(editor::WordIndex{path.string()}, "Invalid index `" + path.string() + "`.");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test editor::print_positions() function"){
+    std::ostringstream oss{};
+    editor::print_positions("word", {1, 5, 12}, oss);
+    REQUIRE(oss.str() == "word 3: 1 5 12\n");
+
+    std::ostringstream oss1{};
+    editor::print_positions("word", {}, oss1);
+    REQUIRE(oss1.str() == "word 0:\n");
+}
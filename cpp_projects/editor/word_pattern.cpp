@@ -0,0 +1,482 @@
+/**
+ * word_pattern.cpp
+ * ----------------
+ * Description:
+ *
+ *     ----- Word Pattern -----
+ *
+ *  A pattern that whole words are matched against, written as a regular expression
+ *  of bytes: `.` matches any byte, `[...]` any byte of a class such as `[a-z_]` or
+ *  `[^0-9]`, `\d` a digit and `\w` a letter, digit or underscore, and `\` takes any
+ *  other character literally. Parts are grouped with `(...)`, alternatives are
+ *  separated by `|`, and `*`, `+` and `?` repeat the part before them zero or more
+ *  times, at least once, or at most once. A pattern always matches a whole word, so
+ *  `un.*` matches the words starting with "un", and `.*ing` those ending with "ing".
+ *
+ *  The pattern is compiled once into a deterministic automaton, with one transition
+ *  per state and class of bytes, so a word is matched in a single pass over its bytes,
+ *  with one table lookup per byte, and stops as soon as no match is possible anymore.
+ *
+ *  Patterns without any special characters, and prefixes, suffixes and infixes such
+ *  as `un.*`, `.*ing` or `.*ab.*`, are not compiled at all, but matched by comparing
+ *  the word with the literal, which searches for infixes with memchr.
+ *
+ **/
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "word_pattern.hpp"
+
+namespace editor {
+    namespace helper {
+        using ByteSet = std::bitset<256>;
+
+        constexpr std::string_view metacharacters{".*+?|()[]\\"};
+
+        // number of states of the automaton above which a pattern is rejected.
+        constexpr std::size_t max_states{10000};
+
+        // a part of a parsed pattern.
+        struct Node{
+            enum class Type{bytes, concatenation, alternation, star, plus, optional};
+
+            Type type{Type::bytes};
+            ByteSet bytes{};
+            std::vector<Node> children{};
+        };
+
+        // a state of the nondeterministic automaton, which either consumes a byte of a set, or moves on without one.
+        struct State{
+            bool consumes{false};
+            ByteSet bytes{};
+            std::size_t next{0};
+            std::vector<std::size_t> epsilon{};
+        };
+
+        // the accepting state of the nondeterministic automaton.
+        constexpr std::size_t accepting_state{0};
+
+        [[noreturn]] void invalid(const std::string_view pattern, const std::string& reason){
+            throw std::invalid_argument("Invalid pattern `" + std::string{pattern} + "`: " + reason + ".");
+        }
+
+        ByteSet single_byte(const char c){
+            ByteSet bytes{};
+            bytes.set(static_cast<unsigned char>(c));
+            return bytes;
+        }
+
+        bool is_literal(const std::string_view pattern){
+            return pattern.find_first_of(metacharacters) == std::string_view::npos;
+        }
+
+        class Parser{
+        public:
+            explicit Parser(const std::string_view pattern)
+                : _pattern{pattern}, _pos{0}
+                {}
+
+            Node parse(){
+                Node node{_alternation()};
+                if(_pos < _pattern.size()){
+                    invalid(_pattern, "unmatched `)`");
+                }
+                return node;
+            }
+
+        private:
+            std::string_view _pattern;
+            std::size_t _pos;
+
+            bool _at(const char c) const{
+                return _pos < _pattern.size() && _pattern[_pos] == c;
+            }
+
+            Node _alternation(){
+                Node node{Node::Type::alternation};
+                node.children.push_back(_concatenation());
+                while(_at('|')){
+                    _pos++;
+                    node.children.push_back(_concatenation());
+                }
+
+                if(node.children.size() == 1){
+                    Node only{std::move(node.children.front())};
+                    return only;
+                }
+                return node;
+            }
+
+            // an empty concatenation matches the empty word.
+            Node _concatenation(){
+                Node node{Node::Type::concatenation};
+                while(_pos < _pattern.size() && !_at('|') && !_at(')')){
+                    node.children.push_back(_repetition());
+                }
+                return node;
+            }
+
+            Node _repetition(){
+                Node node{_atom()};
+                while(_at('*') || _at('+') || _at('?')){
+                    const Node::Type type{_at('*') ? Node::Type::star :
+                                          _at('+') ? Node::Type::plus : Node::Type::optional};
+                    _pos++;
+
+                    Node repeated{type};
+                    repeated.children.push_back(std::move(node));
+                    node = std::move(repeated);
+                }
+                return node;
+            }
+
+            Node _atom(){
+                const char c{_pattern[_pos++]};
+                switch(c){
+                    case '(': {
+                        Node node{_alternation()};
+                        if(!_at(')')){
+                            invalid(_pattern, "unmatched `(`");
+                        }
+                        _pos++;
+                        return node;
+                    }
+                    case '*':
+                    case '+':
+                    case '?':
+                        invalid(_pattern, std::string{"nothing to repeat before `"} + c + "`");
+                    case '.':
+                        return Node{Node::Type::bytes, ByteSet{}.set()};
+                    case '[':
+                        return Node{Node::Type::bytes, _class()};
+                    case '\\':
+                        return Node{Node::Type::bytes, _escape()};
+                    default:
+                        return Node{Node::Type::bytes, single_byte(c)};
+                }
+            }
+
+            ByteSet _escape(){
+                if(_pos == _pattern.size()){
+                    invalid(_pattern, "nothing to escape after `\\`");
+                }
+
+                ByteSet bytes{};
+                const char c{_pattern[_pos++]};
+                if(c == 'd' || c == 'w'){
+                    for(char digit{'0'}; digit <= '9'; digit++){
+                        bytes.set(static_cast<unsigned char>(digit));
+                    }
+                }
+                if(c == 'w'){
+                    for(char letter{'a'}; letter <= 'z'; letter++){
+                        bytes.set(static_cast<unsigned char>(letter));
+                        bytes.set(static_cast<unsigned char>(letter - 'a' + 'A'));
+                    }
+                    bytes.set('_');
+                }
+                return bytes.any() ? bytes : single_byte(c);
+            }
+
+            // a byte, or the bytes of an escape, within a class.
+            ByteSet _member(){
+                if(_pos == _pattern.size()){
+                    invalid(_pattern, "unmatched `[`");
+                }
+                const char c{_pattern[_pos++]};
+                return c == '\\' ? _escape() : single_byte(c);
+            }
+
+            ByteSet _class(){
+                const bool negated{_at('^')};
+                if(negated){
+                    _pos++;
+                }
+
+                const auto single{[](const ByteSet& bytes){
+                    int byte{-1};
+                    if(bytes.count() == 1){
+                        while(!bytes.test(static_cast<std::size_t>(++byte))){}
+                    }
+                    return byte;
+                }};
+
+                // a `]` right after the opening bracket is a member of the class.
+                ByteSet bytes{};
+                for(bool first{true}; first || !_at(']'); first = false){
+                    const ByteSet member{_member()};
+                    if(!_at('-') || _pos + 1 >= _pattern.size() || _pattern[_pos + 1] == ']'){
+                        bytes |= member;
+                        continue;
+                    }
+
+                    _pos++;
+                    const int low{single(member)};
+                    const int high{single(_member())};
+                    if(low < 0 || high < 0 || low > high){
+                        invalid(_pattern, "invalid range in `[...]`");
+                    }
+                    for(int byte{low}; byte <= high; byte++){
+                        bytes.set(static_cast<std::size_t>(byte));
+                    }
+                }
+                _pos++;
+
+                return negated ? ~bytes : bytes;
+            }
+        };
+
+        /**
+         * @brief Add the states of a part of a pattern to a nondeterministic automaton.
+         *
+         * The states are built backwards, from the state that follows the part.
+         *
+         * @param node: the part of the pattern.
+         * @param next: the state to move to after the part is matched.
+         * @param states: the states of the automaton.
+         * @return the first state of the part.
+         */
+        std::size_t add_states(const Node& node, std::size_t next, std::vector<State>& states){
+            switch(node.type){
+                case Node::Type::bytes: {
+                    State state{};
+                    state.consumes = true;
+                    state.bytes = node.bytes;
+                    state.next = next;
+                    states.push_back(std::move(state));
+                    return states.size() - 1;
+                }
+                case Node::Type::concatenation:
+                    for(auto child{node.children.rbegin()}; child != node.children.rend(); child++){
+                        next = add_states(*child, next, states);
+                    }
+                    return next;
+                case Node::Type::alternation: {
+                    State state{};
+                    for(const Node& child : node.children){
+                        state.epsilon.push_back(add_states(child, next, states));
+                    }
+                    states.push_back(std::move(state));
+                    return states.size() - 1;
+                }
+                case Node::Type::star:
+                case Node::Type::plus: {
+                    // a loop back to this state after each repetition.
+                    states.emplace_back();
+                    const std::size_t loop{states.size() - 1};
+                    const std::size_t body{add_states(node.children.front(), loop, states)};
+                    states[loop].epsilon = {body, next};
+                    return node.type == Node::Type::star ? loop : body;
+                }
+                case Node::Type::optional: {
+                    State state{};
+                    state.epsilon = {add_states(node.children.front(), next, states), next};
+                    states.push_back(std::move(state));
+                    return states.size() - 1;
+                }
+            }
+            return next;
+        }
+
+        /**
+         * @brief Find all states reachable from some states without consuming a byte.
+         *
+         * @param states: the states of the automaton.
+         * @param from: the states to start from.
+         * @return the sorted states that consume a byte or accept, which identify a deterministic state.
+         */
+        std::vector<std::size_t> closure(const std::vector<State>& states, std::vector<std::size_t> from){
+            std::vector<bool> visited(states.size());
+            std::vector<std::size_t> reached{};
+
+            while(!from.empty()){
+                const std::size_t state{from.back()};
+                from.pop_back();
+                if(visited[state]){
+                    continue;
+                }
+                visited[state] = true;
+
+                if(states[state].consumes || state == accepting_state){
+                    reached.push_back(state);
+                }
+                from.insert(from.end(), states[state].epsilon.begin(), states[state].epsilon.end());
+            }
+
+            std::ranges::sort(reached);
+            return reached;
+        }
+    }
+
+    /**
+     * @brief Create a pattern, compiling it unless it is matched by comparing literals.
+     *
+     * @param pattern: the pattern, as described at the top of this file.
+     * @throws std::invalid_argument if the pattern is invalid or too complex.
+     */
+    WordPattern::WordPattern(const std::string_view pattern)
+        : _pattern{pattern}, _kind{Kind::automaton}, _literal{}, _classes{}, _num_classes{0}, _transitions{},
+          _accepting{}, _start{0}
+        {
+            const std::size_t size{pattern.size()};
+            const bool leading_any{pattern.starts_with(".*")};
+            const bool trailing_any{pattern.ends_with(".*")};
+
+            if(helper::is_literal(pattern)){
+                _kind = Kind::literal;
+                _literal = pattern;
+            }
+            else if(trailing_any && helper::is_literal(pattern.substr(0, size - 2))){
+                _kind = Kind::prefix;
+                _literal = pattern.substr(0, size - 2);
+            }
+            else if(leading_any && helper::is_literal(pattern.substr(2))){
+                _kind = Kind::suffix;
+                _literal = pattern.substr(2);
+            }
+            else if(leading_any && trailing_any && size >= 4 && helper::is_literal(pattern.substr(2, size - 4))){
+                _kind = Kind::contains;
+                _literal = pattern.substr(2, size - 4);
+            }
+            else{
+                _compile();
+            }
+        }
+
+    /**
+     * @brief Check whether a whole word matches the pattern.
+     *
+     * @param word: the word to match.
+     * @return true if the word matches, else false.
+     */
+    bool WordPattern::matches(const std::string_view word) const{
+        switch(_kind){
+            case Kind::literal:
+                return word == _literal;
+            case Kind::prefix:
+                return word.starts_with(_literal);
+            case Kind::suffix:
+                return word.ends_with(_literal);
+            case Kind::contains:
+                return word.find(_literal) != std::string_view::npos;
+            case Kind::automaton:
+                break;
+        }
+
+        std::uint32_t state{_start};
+        for(const char c : word){
+            state = _transitions[state * _num_classes + _classes[static_cast<unsigned char>(c)]];
+            if(state == 0){
+                return false;
+            }
+        }
+        return _accepting[state];
+    }
+
+    const std::string& WordPattern::pattern() const{
+        return _pattern;
+    }
+
+    // ------------------- PRIVATE FUNCTIONS -------------------
+
+    /**
+     * @brief Compile the pattern into a deterministic automaton.
+     *
+     * The pattern is parsed and turned into a nondeterministic automaton, whose sets
+     * of states that can be reached together become the states of the deterministic
+     * one. Bytes that no part of the pattern tells apart share one column of transitions.
+     *
+     * @throws std::invalid_argument if the pattern is invalid or too complex.
+     */
+    void WordPattern::_compile(){
+        const helper::Node root{helper::Parser{_pattern}.parse()};
+        std::vector<helper::State> states(1);
+        const std::size_t start{helper::add_states(root, helper::accepting_state, states)};
+
+        // split the bytes into classes, one set of bytes of a state at a time.
+        _num_classes = 1;
+        for(const helper::State& state : states){
+            if(!state.consumes){
+                continue;
+            }
+
+            std::map<std::pair<std::uint8_t, bool>, std::uint8_t> renumbered{};
+            for(std::size_t byte{0}; byte < _classes.size(); byte++){
+                const auto key{std::pair{_classes[byte], state.bytes.test(byte)}};
+                _classes[byte] = renumbered.emplace(key, static_cast<std::uint8_t>(renumbered.size())).first->second;
+            }
+            _num_classes = renumbered.size();
+        }
+
+        std::vector<unsigned char> representatives(_num_classes);
+        for(std::size_t byte{_classes.size()}; byte-- > 0;){
+            representatives[_classes[byte]] = static_cast<unsigned char>(byte);
+        }
+
+        // the dead state, from which no word matches, is the empty set of states.
+        std::vector<std::vector<std::size_t>> sets(1);
+        std::map<std::vector<std::size_t>, std::uint32_t> ids{};
+        ids.emplace(sets.front(), 0);
+        const auto add_set{[&](std::vector<std::size_t> set) -> std::uint32_t {
+            if(const auto it{ids.find(set)}; it != ids.end()){
+                return it->second;
+            }
+            if(sets.size() == helper::max_states){
+                helper::invalid(_pattern, "too complex");
+            }
+
+            const auto id{static_cast<std::uint32_t>(sets.size())};
+            ids.emplace(set, id);
+            sets.push_back(std::move(set));
+            return id;
+        }};
+
+        _start = add_set(helper::closure(states, {start}));
+        _transitions.assign(sets.size() * _num_classes, 0);
+
+        for(std::size_t id{1}; id < sets.size(); id++){
+            const std::vector<std::size_t> set{sets[id]};
+            for(std::size_t byte_class{0}; byte_class < _num_classes; byte_class++){
+                std::vector<std::size_t> targets{};
+                for(const std::size_t state : set){
+                    if(states[state].consumes && states[state].bytes.test(representatives[byte_class])){
+                        targets.push_back(states[state].next);
+                    }
+                }
+
+                const std::uint32_t target{add_set(helper::closure(states, std::move(targets)))};
+                _transitions.resize(sets.size() * _num_classes, 0);
+                _transitions[id * _num_classes + byte_class] = target;
+            }
+        }
+
+        _accepting.resize(sets.size());
+        for(std::size_t id{0}; id < sets.size(); id++){
+            _accepting[id] = !sets[id].empty() && sets[id].front() == helper::accepting_state;
+        }
+    }
+
+    /**
+     * @brief Find the words of a frequency table that match a pattern.
+     *
+     * Each distinct word is matched once, however often it occurs in the text.
+     *
+     * @param table: a table of words and their frequencies.
+     * @param pattern: the pattern to match.
+     * @return views of the matching words, owned by the table.
+     */
+    std::vector<std::string_view> matching_words(const FrequencyTable& table, const WordPattern& pattern){
+        std::vector<std::string_view> words{};
+        for(const auto& [word, count] : table){
+            if(pattern.matches(word)){
+                words.push_back(word);
+            }
+        }
+        return words;
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,51 @@
+/**
+ * word_pattern.hpp
+ * ----------------
+ * Description:
+ *   Header file containing declarations for matching whole words against patterns.
+ * */
+
+#ifndef WORD_PATTERN_HPP
+#define WORD_PATTERN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "frequency_table.hpp"
+
+namespace editor {
+    class WordPattern{
+    public:
+        explicit WordPattern(std::string_view pattern);
+
+        bool matches(std::string_view word) const;
+
+        const std::string& pattern() const;
+
+    private:
+        // how a word is matched: by comparing it to a literal, or by running the automaton.
+        enum class Kind{literal, prefix, suffix, contains, automaton};
+
+        std::string _pattern;
+        Kind _kind;
+        std::string _literal;
+        // the class of each byte, where bytes of the same class have the same transitions.
+        std::array<std::uint8_t, 256> _classes;
+        std::size_t _num_classes;
+        // transitions of each state, with one column per class of bytes. State 0 is dead.
+        std::vector<std::uint32_t> _transitions;
+        std::vector<std::uint8_t> _accepting;
+        std::uint32_t _start;
+
+        void _compile();
+    };
+
+    std::vector<std::string_view> matching_words(const FrequencyTable& table, const WordPattern& pattern);
+}
+
+#endif // WORD_PATTERN_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,86 @@
+#include "word_pattern.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <regex>
+#include <string>
+
+TEST_CASE("Test editor::WordPattern matching whole words"){
+    const editor::WordPattern literal{"the"};
+    REQUIRE(literal.matches("the"));
+    REQUIRE_FALSE(literal.matches("then"));
+    REQUIRE_FALSE(literal.matches("th"));
+
+    const editor::WordPattern prefix{"un.*"};
+    REQUIRE(prefix.matches("un"));
+    REQUIRE(prefix.matches("undo"));
+    REQUIRE_FALSE(prefix.matches("fun"));
+
+    const editor::WordPattern suffix{".*ing"};
+    REQUIRE(suffix.matches("sing"));
+    REQUIRE_FALSE(suffix.matches("singer"));
+
+    const editor::WordPattern infix{".*ab.*"};
+    REQUIRE(infix.matches("cabin"));
+    REQUIRE_FALSE(infix.matches("cobin"));
+
+    const editor::WordPattern regex{"(re|un)?do(es|ne)?"};
+    for(const std::string word : {"do", "redo", "undone", "does"}){
+        REQUIRE(regex.matches(word));
+    }
+    for(const std::string word : {"", "re", "redoes!", "dodo"}){
+        REQUIRE_FALSE(regex.matches(word));
+    }
+
+    // classes, escapes and a literal `+`
+    const editor::WordPattern classes{"[A-Z][^0-9]*\\d+"};
+    REQUIRE(classes.matches("Word42"));
+    REQUIRE_FALSE(classes.matches("word42"));
+    REQUIRE_FALSE(classes.matches("Wo1rd2x"));
+    REQUIRE(editor::WordPattern{"C\\+\\+"}.matches("C++"));
+    REQUIRE(editor::WordPattern{"[]a-]+"}.matches("]-a"));
+
+    // bytes of multi-byte characters are matched one at a time
+    REQUIRE(editor::WordPattern{"caf.."}.matches("café"));
+}
+
+TEST_CASE("Test editor::WordPattern against std::regex"){
+    const std::vector<std::string> patterns{"a*b", "(ab|ba)+", "[a-c]?[^a]b*", "a(b|c)*a", ".*a.b", "(a*)*b?",
+                                            "[abc]+c", "b.*c.*", "(a|)(b|)c?"};
+    std::vector<std::string> words{""};
+    for(std::size_t i{0}; words.size() < 4000; i++){
+        for(const char c : {'a', 'b', 'c'}){
+            words.push_back(words[i] + c);
+        }
+    }
+
+    for(const std::string& pattern : patterns){
+        const editor::WordPattern compiled{pattern};
+        const std::regex expected{pattern};
+        for(const std::string& word : words){
+            INFO(pattern << " " << word);
+            REQUIRE(compiled.matches(word) == std::regex_match(word, expected));
+        }
+    }
+}
+
+TEST_CASE("Test editor::WordPattern rejecting invalid patterns"){
+    REQUIRE_THROWS_WITH(editor::WordPattern{"(ab"}, "Invalid pattern `(ab`: unmatched `(`.");
+    REQUIRE_THROWS_WITH(editor::WordPattern{"ab)"}, "Invalid pattern `ab)`: unmatched `)`.");
+    REQUIRE_THROWS_WITH(editor::WordPattern{"[ab"}, "Invalid pattern `[ab`: unmatched `[`.");
+    REQUIRE_THROWS_WITH(editor::WordPattern{"*a"}, "Invalid pattern `*a`: nothing to repeat before `*`.");
+    REQUIRE_THROWS_WITH(editor::WordPattern{"a\\"}, "Invalid pattern `a\\`: nothing to escape after `\\`.");
+    REQUIRE_THROWS_WITH(editor::WordPattern{"[z-a]"}, "Invalid pattern `[z-a]`: invalid range in `[...]`.");
+    // the automaton of a word whose 16th last letter is `a` has too many states
+    REQUIRE_THROWS_WITH(editor::WordPattern{".*a..............."},
+                        "Invalid pattern `.*a...............`: too complex.");
+}
+
+TEST_CASE("Test editor::matching_words() function"){
+    const std::vector<std::string> text{"undo", "redo", "do", "undo", "done", "sing"};
+    const editor::FrequencyTable table{editor::create_frequency_table(text)};
+
+    std::vector<std::string_view> words{editor::matching_words(table, editor::WordPattern{".*do"})};
+    std::ranges::sort(words);
+    REQUIRE(words == std::vector<std::string_view>{"do", "redo", "undo"});
+    REQUIRE(editor::matching_words(table, editor::WordPattern{"x.*"}).empty());
+}
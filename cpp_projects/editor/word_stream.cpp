@@ -0,0 +1,147 @@
+/**
+ * word_stream.cpp
+ * ---------------
+ * Description:
+ *
+ *     ----- Word Stream -----
+ *
+ *  Reads the words of a text from a stream, one chunk at a time, so that texts much
+ *  larger than the memory can be processed. Only one chunk is held at a time: every
+ *  chunk is cut after its last whitespace, and the beginning of a word that is cut
+ *  is carried over to the next chunk. A chunk only grows when a single word does not
+ *  fit in it.
+ *
+ *  The words are split the same way as `split_words`, and are views into the chunk,
+ *  valid until the next chunk is read.
+ *
+ **/
+
+#include <algorithm>
+#include <cstring>
+#include "output_buffer.hpp"
+#include "tokenizer.hpp"
+#include "word_stream.hpp"
+
+namespace {
+    // whitespace as classified by std::isspace in the "C" locale.
+    constexpr bool is_space(const char c){
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+}
+
+namespace editor {
+    /**
+     * @brief Create a stream of words read from an input stream.
+     *
+     * @param is: the input stream, which must outlive the word stream.
+     * @param chunk_size: number of characters read at a time.
+     */
+    WordStream::WordStream(std::istream& is, const std::size_t chunk_size)
+        : _is{is}, _buffer(std::max<std::size_t>(chunk_size, 1)), _size{0}, _consumed{0}, _end{false}
+        {}
+
+    /**
+     * @brief Read the words of the next chunk.
+     *
+     * @param words: vector that is filled with views of the words of the chunk.
+     * @return false when there are no more words, else true.
+     */
+    bool WordStream::next(std::vector<std::string_view>& words){
+        words.clear();
+
+        // the cut word of the previous chunk is moved to the beginning of the buffer.
+        std::memmove(_buffer.data(), _buffer.data() + _consumed, _size - _consumed);
+        _size -= _consumed;
+        _consumed = 0;
+
+        while(words.empty()){
+            if(_end && _size == 0){
+                return false;
+            }
+
+            if(!_end){
+                if(_size == _buffer.size()){
+                    _buffer.resize(_buffer.size() * 2);
+                }
+                _is.read(_buffer.data() + _size, static_cast<std::streamsize>(_buffer.size() - _size));
+                _size += static_cast<std::size_t>(_is.gcount());
+                _end = !_is;
+            }
+
+            std::size_t cut{_size};
+            if(!_end){
+                const auto last_space{std::find_if(std::make_reverse_iterator(_buffer.begin() + _size),
+                                                   _buffer.rend(), is_space)};
+                if(last_space == _buffer.rend()){
+                    continue;
+                }
+                cut = static_cast<std::size_t>(last_space.base() - _buffer.begin());
+            }
+
+            words = split_words({_buffer.data(), cut});
+            _consumed = cut;
+
+            if(words.empty()){
+                std::memmove(_buffer.data(), _buffer.data() + cut, _size - cut);
+                _size -= cut;
+                _consumed = 0;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Create a frequency table of all words read from a stream.
+     *
+     * Only the distinct words are kept, not the text.
+     *
+     * @param is: an input stream of text.
+     * @return a table of words and their frequencies.
+     */
+    FrequencyTable stream_frequency_table(std::istream& is){
+        FrequencyTable table{};
+        WordStream stream{is};
+        std::vector<std::string_view> words{};
+
+        while(stream.next(words)){
+            std::ranges::for_each(words, [&table](const std::string_view word){table.add(word);});
+        }
+
+        return table;
+    }
+
+    /**
+     * @brief Print all words read from a stream, edited and separated by space.
+     *
+     * The output is the same as `print_text` of the edited text, but only one
+     * chunk of the text is held at a time.
+     *
+     * @param is: an input stream of text.
+     * @param edits: the edits applied to the words.
+     * @param os: an output stream.
+     * @param normalizer: normalizes the words before they are edited, if given.
+     */
+    void stream_text(std::istream& is, const WordEdits& edits, std::ostream& os, Normalizer* const normalizer){
+        WordStream stream{is};
+        std::vector<std::string_view> words{};
+
+        {
+            OutputBuffer output{os};
+            while(stream.next(words)){
+                if(normalizer){
+                    normalizer->apply(words);
+                }
+                edits.apply(words);
+                std::ranges::for_each(words, [&output](const std::string_view word){
+                    output.write(word);
+                    output.write(' ');
+                });
+            }
+        }
+
+        os << std::endl;
+    }
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,47 @@
+/**
+ * word_stream.hpp
+ * ---------------
+ * Description:
+ *   Header file containing declarations for reading words from a stream in chunks.
+ * */
+
+#ifndef WORD_STREAM_HPP
+#define WORD_STREAM_HPP
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "frequency_table.hpp"
+#include "normalizer.hpp"
+#include "word_edits.hpp"
+
+namespace editor {
+    class WordStream{
+    public:
+        explicit WordStream(std::istream& is, std::size_t chunk_size = 1 << 20);
+
+        WordStream(const WordStream&) = delete;
+        WordStream& operator=(const WordStream&) = delete;
+
+        ~WordStream() = default;
+
+        bool next(std::vector<std::string_view>& words);
+
+    private:
+        std::istream& _is;
+        std::vector<char> _buffer;
+        std::size_t _size;
+        std::size_t _consumed;
+        bool _end;
+    };
+
+    FrequencyTable stream_frequency_table(std::istream& is);
+
+    void stream_text(std::istream& is, const WordEdits& edits, std::ostream& os, Normalizer* normalizer = nullptr);
+}
+
+#endif // WORD_STREAM_HPP
+
+// ============== END OF FILE ==============
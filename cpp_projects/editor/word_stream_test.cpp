@@ -0,0 +1,57 @@
+#include "word_stream.hpp"
+#include "tokenizer.hpp"
+#include "editor.hpp"
+#include "../../test/catch.hpp"
+#include <sstream>
+#include <string>
+
+TEST_CASE("Test editor::WordStream class"){
+    std::string text{"  first second\n\tthird "};
+    for(int i{0}; i < 500; i++){
+        text += "w" + std::to_string(i % 37) + (i % 3 == 0 ? "\n" : "  ");
+    }
+    text += std::string(100, 'x') + "   " + std::string(40, ' ') + "last";
+    const std::vector<std::string_view> expected{editor::split_words(text)};
+
+    // chunks smaller than the words, and larger than the text
+    for(const std::size_t chunk_size : {1ul, 7ul, 64ul, 1ul << 20}){
+        std::istringstream iss{text};
+        editor::WordStream stream{iss, chunk_size};
+        std::vector<std::string> words{};
+        std::vector<std::string_view> chunk{};
+
+        while(stream.next(chunk)){
+            REQUIRE_FALSE(chunk.empty());
+            words.insert(words.end(), chunk.begin(), chunk.end());
+        }
+        REQUIRE(std::ranges::equal(words, expected));
+        REQUIRE_FALSE(stream.next(chunk));
+    }
+
+    // no words
+    std::istringstream empty{" \n\t "};
+    editor::WordStream stream{empty, 2};
+    std::vector<std::string_view> chunk{};
+    REQUIRE_FALSE(stream.next(chunk));
+}
+
+TEST_CASE("Test editor::stream_text() and editor::stream_frequency_table() functions"){
+    const std::string text{"a b c\na d  b e\n"};
+    const std::vector<std::string_view> views{editor::split_words(text)};
+    std::vector<std::string> words(views.begin(), views.end());
+
+    std::istringstream iss{text};
+    REQUIRE(editor::stream_frequency_table(iss) == editor::create_frequency_table(words));
+
+    editor::WordEdits edits{};
+    edits.substitute("a", "b");
+    edits.remove("d");
+
+    std::istringstream iss1{text};
+    std::ostringstream oss{};
+    editor::stream_text(iss1, edits, oss);
+
+    std::ostringstream expected{};
+    editor::print_text(editor::remove_word(editor::substitute_word(words, "a", "b"), "d"), expected);
+    REQUIRE(oss.str() == expected.str());
+}
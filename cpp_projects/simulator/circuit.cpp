@@ -119,7 +119,9 @@ void Connection::decrease_charge(double c){
  * 
  */
 
-float Component::time_step = 0.0;  // Static variable definition of Component class
+// Static variable definition of Component class. Each thread has its own time step, so that
+// circuits with different time steps can be simulated concurrently.
+thread_local float Component::time_step = 0.0;
 
 /**
  * @brief Initializing a Component object.
@@ -373,20 +375,24 @@ void Circuit::step(){
 /**
  * @brief Printing the titles and subtitles for the simulation.
  * 
+ * @param os: an output stream, by default std::cout is used.
+ * 
  */ 
-void Circuit::print_titles(){
-	_print_top_titles();
-	_print_sub_titles();
+void Circuit::print_titles(std::ostream& os) const{
+	_print_top_titles(os);
+	_print_sub_titles(os);
 }
 
 /**
  * @brief Printing all component's voltage and current at the moment.
  * 
+ * @param os: an output stream, by default std::cout is used.
+ * 
  */
-void Circuit::step_print() const{
-	std::cout << std::fixed << std::setprecision(2);
+void Circuit::step_print(std::ostream& os) const{
+	os << std::fixed << std::setprecision(2);
 	for(Component* el : _list){
-		std::cout << std::setw(6) << el->get_voltage() << std::setw(6) << el->get_current();
+		os << std::setw(6) << el->get_voltage() << std::setw(6) << el->get_current();
 	}
 }
 
@@ -409,17 +415,17 @@ const std::vector<Component*>& Circuit::get_list() const{
 	return _list;
 }
 
-void Circuit::_print_top_titles() const{
+void Circuit::_print_top_titles(std::ostream& os) const{
 	for(Component* el : _list){
-		std::cout << std::setw(12) << el->get_name();
+		os << std::setw(12) << el->get_name();
 	}
-	std::cout << std::endl;
+	os << std::endl;
 }
 
-void Circuit::_print_sub_titles() const{
+void Circuit::_print_sub_titles(std::ostream& os) const{
 	for(long unsigned int i{0}; i < _list.size(); i++){
-		std::cout << std::setw(6) << "Volt" << std::setw(6) << "Curr";
+		os << std::setw(6) << "Volt" << std::setw(6) << "Curr";
 	}
-	std::cout << std::endl;
+	os << std::endl;
 }
 // ============== END OF FILE ==============
@@ -32,7 +32,7 @@ public:
 	
 	virtual ~Component() = default;
 
-	static float time_step;
+	static thread_local float time_step;
 
 	virtual void step() = 0;
 
@@ -102,9 +102,9 @@ public:
 
 	void step();
 
-	void print_titles();
+	void print_titles(std::ostream& os = std::cout) const;
 
-	void step_print() const;
+	void step_print(std::ostream& os = std::cout) const;
 
 	void add_component(Component* comp);
 
@@ -113,8 +113,8 @@ public:
 private:
 	std::vector<Component*> _list;
 
-	void _print_top_titles() const;
-	void _print_sub_titles() const;
+	void _print_top_titles(std::ostream& os) const;
+	void _print_sub_titles(std::ostream& os) const;
 };
 
 void simulate();
@@ -1,6 +1,54 @@
 #include "circuit.hpp"
+#include "networks.hpp"
+#include "static_circuit.hpp"
 #include "../../test/catch.hpp"
 #include <sstream>
+#include <string>
+
+// -------------- HELPERS --------------
+
+namespace {
+	// the printed titles and steps of a circuit, stepped `steps` times and printed every `print_step`-th step.
+	template<typename Print, typename Step>
+	std::string printed(Print print_titles, Step step_print, int steps, int print_step){
+		std::ostringstream oss{};
+		print_titles(oss);
+		try{
+			for(int step = 0; step < steps; step++){
+				step_print(oss, (step+1) % print_step == 0);
+			}
+		}
+		catch(std::invalid_argument& e){
+			oss << "ERROR: " << e.what();
+		}
+		return oss.str();
+	}
+
+	// the same as `printed` for a Circuit.
+	std::string printed(Circuit& circuit, int steps, int print_step){
+		return printed([&circuit](std::ostream& os){ circuit.print_titles(os); },
+					   [&circuit](std::ostream& os, bool print){
+						   circuit.step();
+						   if(print){
+							   circuit.step_print(os);
+							   os << '\n';
+						   }
+					   }, steps, print_step);
+	}
+
+	// the same as `printed` for a StaticCircuit with the names of its components.
+	template<typename C, std::size_t Size>
+	std::string printed(C& circuit, const std::array<std::string_view, Size>& names, int steps, int print_step){
+		return printed([&circuit, &names](std::ostream& os){ circuit.print_titles(names, os); },
+					   [&circuit](std::ostream& os, bool print){
+						   circuit.step();
+						   if(print){
+							   circuit.step_print(os);
+							   os << '\n';
+						   }
+					   }, steps, print_step);
+	}
+}
 
 // -------------- UNIT TESTS --------------
 
@@ -182,6 +230,166 @@ TEST_CASE("Test Circuit"){
 	REQUIRE(list2.size() == 2);
 }
 
+// --- Class StaticCircuit ---
+TEST_CASE("StaticCircuit: Test step method"){
+	// a constant expression circuit can be stepped at compile time
+	constexpr double charge{[]{
+		StaticCircuit<3, StaticBattery<0, 1>, StaticResistor<0, 2>> c{0.5f, {10}, {5}};
+		c.step();
+		c.step();
+		return c.get_charge<2>();
+	}()};
+	STATIC_REQUIRE(charge == 1.0);
+
+	StaticCircuit<2, StaticBattery<0, 1>, StaticCapacitor<0, 1>> circuit{0.1f, {12}, {0.5}};
+	REQUIRE(circuit.size() == 2);
+	REQUIRE(circuit.get_voltage<0>() == 12);
+	REQUIRE(circuit.get_voltage<1>() == 0);
+
+	circuit.step();
+	REQUIRE(circuit.get_charge<0>() == 12);
+	REQUIRE(circuit.get_charge<1>() == 0);
+	REQUIRE(circuit.get_voltage<1>() == 12);
+	REQUIRE(circuit.get_current<1>() == 0.5 * 12);
+}
+
+TEST_CASE("StaticCircuit: Identical results to Circuit"){
+	int steps{20000};
+	float time{0.01};
+	Component::time_step = time;
+	double voltage{24.0};
+
+	Circuit circuit{};
+	Connection P, N, R, L;
+
+	circuit.add_component(new Battery("Bat", voltage, P, N));
+	circuit.add_component(new Resistor("R1", 150, P, L));
+	circuit.add_component(new Resistor("R2", 50, P, R));
+	circuit.add_component(new Capacitor("C3", 1.0, L, R));
+	circuit.add_component(new Resistor("R4", 300, L, N));
+	circuit.add_component(new Capacitor("C5", 0.75, R, N));
+
+	// connection points: P = 0, N = 1, L = 2, R = 3
+	StaticCircuit<4, StaticBattery<0, 1>, StaticResistor<0, 2>, StaticResistor<0, 3>, StaticCapacitor<2, 3>,
+				  StaticResistor<2, 1>, StaticCapacitor<3, 1>> fixed{time, {voltage}, {150}, {50}, {1.0}, {300}, {0.75}};
+
+	for(int step = 0; step < steps; step++){
+		circuit.step();
+		fixed.step();
+	}
+
+	std::vector<Component*> const& list{circuit.get_list()};
+
+	REQUIRE(fixed.get_charge<0>() == P.get_charge());
+	REQUIRE(fixed.get_charge<1>() == N.get_charge());
+	REQUIRE(fixed.get_charge<2>() == L.get_charge());
+	REQUIRE(fixed.get_charge<3>() == R.get_charge());
+
+	REQUIRE(fixed.get_voltage<0>() == list.at(0)->get_voltage());
+	REQUIRE(fixed.get_voltage<1>() == list.at(1)->get_voltage());
+	REQUIRE(fixed.get_voltage<3>() == list.at(3)->get_voltage());
+	REQUIRE(fixed.get_voltage<5>() == list.at(5)->get_voltage());
+	REQUIRE(fixed.get_current<2>() == list.at(2)->get_current());
+	REQUIRE(fixed.get_current<4>() == list.at(4)->get_current());
+	REQUIRE(fixed.get_current<5>() == list.at(5)->get_current());
+}
+
+TEST_CASE("StaticCircuit: Test charge checks"){
+	// the resistor moves 10 / 1 * 5 = 50 in the second step, more than the 10 of the battery
+	Component::time_step = 5;
+	Circuit circuit{};
+	Connection P, N, L;
+	circuit.add_component(new Battery("Bat", 10, P, N));
+	circuit.add_component(new Resistor("R1", 1, P, L));
+
+	StaticCircuit<3, StaticBattery<0, 1>, StaticResistor<0, 2>> fixed{5, {10}, {1}};
+
+	circuit.step();
+	fixed.step();
+	REQUIRE_THROWS_WITH(circuit.step(), "Charge too high. Will result in invalid charge.");
+	REQUIRE_THROWS_WITH(fixed.step(), "Charge too high. Will result in invalid charge.");
+}
+
+TEST_CASE("StaticCircuit: Networks of simulate print the same as Circuit"){
+	const int steps{20000};
+	const int print_step{2000};
+	double voltage{24.0};
+
+	// a time step where the capacitors eventually refuse a charge, for the same output and error
+	for(const float time : {0.01f, 1.0f}){
+		Component::time_step = time;
+		{
+			Circuit circuit{};
+			Connection P, N, R23, R124;
+			circuit.add_component(new Battery("Bat", voltage, P, N));
+			circuit.add_component(new Resistor("R1", 6, P, R124));
+			circuit.add_component(new Resistor("R2", 4, R124, R23));
+			circuit.add_component(new Resistor("R3", 8, R23, N));
+			circuit.add_component(new Resistor("R4", 12, R124, N));
+
+			FourResistorsNetwork fixed{four_resistors_network(time, voltage)};
+			REQUIRE(printed(fixed, four_resistors_names, steps, print_step) == printed(circuit, steps, print_step));
+		}
+		{
+			Circuit circuit{};
+			Connection P, N, L, R;
+			circuit.add_component(new Battery("Bat", voltage, P, N));
+			circuit.add_component(new Resistor("R1", 150, P, L));
+			circuit.add_component(new Resistor("R2", 50, P, R));
+			circuit.add_component(new Resistor("R3", 100, L, R));
+			circuit.add_component(new Resistor("R4", 300, L, N));
+			circuit.add_component(new Resistor("R5", 250, R, N));
+
+			FiveResistorsNetwork fixed{five_resistors_network(time, voltage)};
+			REQUIRE(printed(fixed, five_resistors_names, steps, print_step) == printed(circuit, steps, print_step));
+		}
+		{
+			Circuit circuit{};
+			Connection P, N, L, R;
+			circuit.add_component(new Battery("Bat", voltage, P, N));
+			circuit.add_component(new Resistor("R1", 150, P, L));
+			circuit.add_component(new Resistor("R2", 50, P, R));
+			circuit.add_component(new Capacitor("C3", 1.0, L, R));
+			circuit.add_component(new Resistor("R4", 300, L, N));
+			circuit.add_component(new Capacitor("C5", 0.75, R, N));
+
+			CapacitorsNetwork fixed{capacitors_network(time, voltage)};
+			REQUIRE(printed(fixed, capacitors_names, steps, print_step) == printed(circuit, steps, print_step));
+		}
+	}
+}
+
+// hidden, run with `SimulatorTest [.benchmark]`
+TEST_CASE("StaticCircuit: Throughput compared to Circuit", "[.benchmark]"){
+	const float time{0.01f};
+	Component::time_step = time;
+
+	Circuit circuit{};
+	Connection P, N, L, R;
+	circuit.add_component(new Battery("Bat", 24, P, N));
+	circuit.add_component(new Resistor("R1", 150, P, L));
+	circuit.add_component(new Resistor("R2", 50, P, R));
+	circuit.add_component(new Capacitor("C3", 1.0, L, R));
+	circuit.add_component(new Resistor("R4", 300, L, N));
+	circuit.add_component(new Capacitor("C5", 0.75, R, N));
+
+	CapacitorsNetwork fixed{capacitors_network(time, 24)};
+
+	// 1000 steps of the third network of simulate
+	BENCHMARK("Circuit"){
+		for(int step = 0; step < 1000; step++){
+			circuit.step();
+		}
+		return circuit.get_list().at(5)->get_voltage();
+	};
+	BENCHMARK("StaticCircuit"){
+		for(int step = 0; step < 1000; step++){
+			fixed.step();
+		}
+		return fixed.get_voltage<5>();
+	};
+}
+
 // ----------- INTERGATION TESTS ----------
 TEST_CASE("Integration test: One battery with four resistors"){
 	int steps{200000}; 
@@ -0,0 +1,224 @@
+/**
+ * flat_circuit.cpp
+ * ----------------
+ * Description:
+ *
+ * 	----- Flat Circuit -----
+ *
+ * 	An index-based stepper for circuits built from a CircuitPlan. Instead of one
+ * 	heap-allocated object per component and per connection point, the state of the
+ * 	circuit is kept in flat arrays: one entry per component for its voltage, current
+ * 	and stored charge, and one entry per connection point for its charge. The
+ * 	components refer to their connection points by index.
+ *
+ * 	The components follow exactly the same rules as Battery, Resistor and Capacitor
+ * 	in circuit.cpp, in the same order of operations, so stepping a FlatCircuit gives
+ * 	the same results as stepping the equivalent Circuit. The charges are checked
+ * 	like in Connection, so a step fails with the same error as in Circuit.
+ *
+ * 	Optionally the energy of every component is accumulated while stepping. The
+ * 	energy transferred to a resistor or a capacitor in a step is the charge it moves
+ * 	times the voltage over it, i.e. the energy dissipated by a resistor and the energy
+ * 	stored in a capacitor. The energy of a battery is the energy it delivers, which
+ * 	is its voltage times the charge it puts back on its positive terminal.
+ *
+ * 	*/
+
+#include <iomanip>
+#include <stdexcept>
+#include "flat_circuit.hpp"
+
+/**
+ * @brief Initializing a circuit where all connection points have zero charge.
+ *
+ * @param plan: the compiled description of the circuit.
+ * @param time_step: the step size used for time, in seconds.
+ * @param track_energy: whether the energy of the components is accumulated.
+ *
+ */
+FlatCircuit::FlatCircuit(const CircuitPlan& plan, float time_step, bool track_energy)
+	: _time_step{time_step}, _track_energy{track_energy}, _names{plan.names}, _types{plan.types},
+	  _values{plan.values}, _terminals_a{plan.terminals_a}, _terminals_b{plan.terminals_b},
+	  _voltages(plan.types.size()), _currents(plan.types.size()), _charges_stored(plan.types.size()),
+	  _charges(plan.num_nodes), _energies(plan.types.size())
+{
+	// like Component, a battery starts with its own voltage over it
+	for(std::size_t i{0}; i < _types.size(); i++){
+		if(_types.at(i) == ComponentType::battery){
+			_voltages.at(i) = _values.at(i);
+		}
+	}
+}
+
+/**
+ * @brief Copying a circuit in its current state, to be stepped with another time step.
+ *
+ * A circuit that is run many times is built once, and every run starts from a copy of it.
+ *
+ * @param circuit: the circuit to copy.
+ * @param time_step: the step size used for time, in seconds.
+ * @param track_energy: whether the energy of the components is accumulated.
+ *
+ */
+FlatCircuit::FlatCircuit(const FlatCircuit& circuit, float time_step, bool track_energy)
+	: FlatCircuit{circuit}
+{
+	_time_step = time_step;
+	_track_energy = track_energy;
+}
+
+/**
+ * @brief Stepping the circuit network.
+ *
+ * All components are stepped once, in order.
+ *
+ * @throws std::invalid_argument if a component would move a negative charge,
+ *  or more charge than the connection point it is taken from has.
+ *
+ */
+void FlatCircuit::step(){
+	if(_track_energy){
+		_step<true>();
+	}
+	else{
+		_step<false>();
+	}
+}
+
+// one step over all components, accumulating energies only when `TrackEnergy` is set.
+template<bool TrackEnergy>
+void FlatCircuit::_step(){
+	double* charges{_charges.data()};
+
+	for(std::size_t i{0}; i < _types.size(); i++){
+		double& a{charges[_terminals_a[i]]};
+		double& b{charges[_terminals_b[i]]};
+
+		if(_types[i] == ComponentType::battery){
+			if constexpr(TrackEnergy){
+				_energies[i] += _voltages[i] * (_voltages[i] - a);
+			}
+			a = _voltages[i];
+			b = 0.0;
+			continue;
+		}
+
+		const double moved{_types[i] == ComponentType::resistor
+		                   ? (_voltages[i] / _values[i]) * _time_step
+		                   : _values[i] * (_voltages[i] - _charges_stored[i]) * _time_step};
+
+		// the same checks as Connection, made before any charge is changed.
+		if(moved < 0){
+			throw std::invalid_argument("Charge cannot be negative.");
+		}
+		if(moved > (a > b ? a : b)){
+			throw std::invalid_argument("Charge too high. Will result in invalid charge.");
+		}
+
+		if constexpr(TrackEnergy){
+			_energies[i] += moved * _voltages[i];
+		}
+
+		if(a > b){
+			a -= moved;
+			b += moved;
+		}
+		else{
+			a += moved;
+			b -= moved;
+		}
+
+		if(_types[i] == ComponentType::capacitor){
+			_charges_stored[i] += moved;
+		}
+
+		_voltages[i] = a > b ? a - b : b - a;
+
+		if(_types[i] == ComponentType::resistor){
+			_currents[i] = _voltages[i] / _values[i];
+		}
+		else{
+			_currents[i] = _values[i] * (_voltages[i] - _charges_stored[i]);
+		}
+	}
+}
+
+/**
+ * @brief Getting the energy of a component since the start of the simulation.
+ *
+ * Energy is only accumulated when the circuit was initialized with `track_energy`.
+ *
+ * @param index: index of the component.
+ * @return energy delivered by a battery, dissipated by a resistor or stored in a capacitor.
+ *
+ */
+double FlatCircuit::get_energy(std::size_t index) const{
+	return _energies.at(index);
+}
+
+/**
+ * @brief Printing the names of the components, followed by a voltage and a current title for each.
+ *
+ * The same titles as Circuit::print_titles prints.
+ *
+ * @param os: an output stream, by default std::cout is used.
+ *
+ */
+void FlatCircuit::print_titles(std::ostream& os) const{
+	for(const std::string& name : _names){
+		os << std::setw(12) << name;
+	}
+	os << std::endl;
+
+	for(std::size_t i{0}; i < _names.size(); i++){
+		os << std::setw(6) << "Volt" << std::setw(6) << "Curr";
+	}
+	os << std::endl;
+}
+
+/**
+ * @brief Printing all component's voltage and current at the moment.
+ *
+ * The same line as Circuit::step_print prints.
+ *
+ * @param os: an output stream, by default std::cout is used.
+ *
+ */
+void FlatCircuit::step_print(std::ostream& os) const{
+	os << std::fixed << std::setprecision(2);
+	for(std::size_t i{0}; i < _voltages.size(); i++){
+		os << std::setw(6) << _voltages[i] << std::setw(6) << _currents[i];
+	}
+}
+
+/**
+ * @brief Printing the energy of every component, in joules, under the name of the component.
+ *
+ * @param os: an output stream, by default std::cout is used.
+ *
+ */
+void FlatCircuit::print_energies(std::ostream& os) const{
+	os << std::fixed << std::setprecision(2);
+	for(const double energy : _energies){
+		os << std::setw(12) << energy;
+	}
+	os << std::endl;
+}
+
+std::size_t FlatCircuit::size() const{
+	return _types.size();
+}
+
+double FlatCircuit::get_voltage(std::size_t index) const{
+	return _voltages.at(index);
+}
+
+double FlatCircuit::get_current(std::size_t index) const{
+	return _currents.at(index);
+}
+
+double FlatCircuit::get_charge(std::size_t node) const{
+	return _charges.at(node);
+}
+
+// ============== END OF FILE ==============
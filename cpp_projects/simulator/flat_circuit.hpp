@@ -0,0 +1,63 @@
+/**
+ * flat_circuit.hpp
+ * ----------------
+ * Description:
+ * 	Header file containing declarations for the index-based circuit stepper.
+ * */
+
+#ifndef FLAT_CIRCUIT_HPP
+#define FLAT_CIRCUIT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "netlist.hpp"
+
+class FlatCircuit{
+public:
+	FlatCircuit(const CircuitPlan& plan, float time_step, bool track_energy = false);
+
+	FlatCircuit(const FlatCircuit& circuit, float time_step, bool track_energy = false);
+
+	void step();
+
+	std::size_t size() const;
+
+	double get_voltage(std::size_t index) const;
+
+	double get_current(std::size_t index) const;
+
+	double get_charge(std::size_t node) const;
+
+	double get_energy(std::size_t index) const;
+
+	void print_titles(std::ostream& os = std::cout) const;
+
+	void step_print(std::ostream& os = std::cout) const;
+
+	void print_energies(std::ostream& os = std::cout) const;
+
+private:
+	double _time_step;
+	bool _track_energy;
+	std::vector<std::string> _names;
+	std::vector<ComponentType> _types;
+	std::vector<double> _values;
+	std::vector<std::uint32_t> _terminals_a;
+	std::vector<std::uint32_t> _terminals_b;
+
+	std::vector<double> _voltages;
+	std::vector<double> _currents;
+	std::vector<double> _charges_stored;
+	std::vector<double> _charges;
+	std::vector<double> _energies;
+
+	template<bool TrackEnergy>
+	void _step();
+};
+
+#endif // FLAT_CIRCUIT_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,256 @@
+#include "flat_circuit.hpp"
+#include "../../test/catch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+
+// -------------- HELPERS --------------
+
+namespace {
+	/**
+	 * @brief Generating a random connected circuit.
+	 *
+	 * A battery is connected between the first two connection points, every other
+	 * connection point is connected by a resistor to one that came before it, and
+	 * the remaining components connect random pairs of connection points.
+	 *
+	 * @param seed: seed of the random number generator.
+	 * @param num_nodes: number of connection points, at least two.
+	 * @param num_components: number of components, at least `num_nodes`.
+	 * @param with_capacitors: whether about a third of the random pairs are connected by capacitors.
+	 * @return the netlist.
+	 */
+	Netlist random_netlist(unsigned seed, int num_nodes, int num_components, bool with_capacitors){
+		std::mt19937 generator{seed};
+		std::uniform_int_distribution<int> kind{0, 2};
+		std::uniform_real_distribution<double> resistance{50, 500};
+		std::uniform_real_distribution<double> capacitance{0.1, 1.0};
+
+		Netlist netlist{};
+		netlist.add_component({"Battery", "Bat", 24, "N0", "N1"});
+
+		for(int i{1}; i < num_components; i++){
+			int a{};
+			int b{};
+			if(i + 1 < num_nodes){
+				a = i + 1;
+				b = std::uniform_int_distribution<int>{0, i}(generator);
+			}
+			else{
+				a = std::uniform_int_distribution<int>{0, num_nodes - 1}(generator);
+				b = (a + std::uniform_int_distribution<int>{1, num_nodes - 1}(generator)) % num_nodes;
+			}
+
+			const bool is_capacitor{with_capacitors && i + 1 >= num_nodes && kind(generator) == 0};
+			netlist.add_component({is_capacitor ? "Capacitor" : "Resistor", "X" + std::to_string(i),
+								   is_capacitor ? capacitance(generator) : resistance(generator),
+								   "N" + std::to_string(a), "N" + std::to_string(b)});
+		}
+
+		return netlist;
+	}
+
+	struct Divergence{
+		int steps_compared;
+		int first_step;
+		double max_error;
+		std::string reference_error;
+		std::string flat_error;
+	};
+
+	/**
+	 * @brief Stepping a Circuit and a FlatCircuit in lockstep, comparing every component after every step.
+	 *
+	 * Connection refuses charges that would become negative, which some capacitor networks
+	 * reach after a while. The comparison stops at the first step where either circuit throws.
+	 *
+	 * @return the number of steps compared, the first step where any voltage or current differ
+	 * 	(-1 if none), the largest difference, and the errors thrown by each circuit at the last step.
+	 */
+	Divergence compare(const Netlist& netlist, int steps, float time_step){
+		Component::time_step = time_step;
+		const CircuitPlan plan{netlist.compile()};
+		NetlistCircuit reference{plan};
+		FlatCircuit flat{plan, time_step};
+		const std::vector<Component*>& list{reference.get_circuit().get_list()};
+
+		Divergence divergence{0, -1, 0, "", ""};
+		for(int step = 0; step < steps; step++){
+			try{
+				reference.get_circuit().step();
+			}
+			catch(std::invalid_argument& e){
+				divergence.reference_error = e.what();
+			}
+			try{
+				flat.step();
+			}
+			catch(std::invalid_argument& e){
+				divergence.flat_error = e.what();
+			}
+			if(!divergence.reference_error.empty() || !divergence.flat_error.empty()){
+				break;
+			}
+			divergence.steps_compared++;
+
+			for(std::size_t i{0}; i < list.size(); i++){
+				const double error{std::max(std::abs(list.at(i)->get_voltage() - flat.get_voltage(i)),
+											std::abs(list.at(i)->get_current() - flat.get_current(i)))};
+				if(error > 0 && divergence.first_step < 0){
+					divergence.first_step = step;
+				}
+				divergence.max_error = std::max(divergence.max_error, error);
+			}
+		}
+
+		return divergence;
+	}
+}
+
+// -------------- UNIT TESTS --------------
+
+// --- Class FlatCircuit ---
+TEST_CASE("FlatCircuit: Test step method"){
+	std::istringstream text{"Battery Bat 12 P N\nCapacitor C1 0.5 P N\n"};
+	FlatCircuit circuit{Netlist{text}.compile(), 0.1};
+	REQUIRE(circuit.size() == 2);
+	REQUIRE(circuit.get_voltage(0) == 12);
+	REQUIRE(circuit.get_voltage(1) == 0);
+
+	circuit.step();
+	REQUIRE(circuit.get_charge(0) == 12);
+	REQUIRE(circuit.get_charge(1) == 0);
+	REQUIRE(circuit.get_voltage(1) == 12);
+	REQUIRE(circuit.get_current(1) == 0.5 * 12);
+	REQUIRE(circuit.get_current(0) == 0);
+}
+
+TEST_CASE("FlatCircuit: Test energy accounting"){
+	const int steps{20000};
+	const float time{0.01};
+	std::istringstream text{"Battery Bat 24 P N\nResistor R1 6 P L\nResistor R2 4 L N\nCapacitor C3 0.5 L N\n"};
+	const CircuitPlan plan{Netlist{text}.compile()};
+
+	// energy is not accumulated by default
+	FlatCircuit untracked{plan, time};
+	FlatCircuit tracked{plan, time, true};
+	for(int step = 0; step < steps; step++){
+		untracked.step();
+		tracked.step();
+	}
+
+	for(std::size_t i{0}; i < plan.types.size(); i++){
+		REQUIRE(untracked.get_energy(i) == 0);
+		REQUIRE(tracked.get_voltage(i) == untracked.get_voltage(i));
+		REQUIRE(tracked.get_current(i) == untracked.get_current(i));
+	}
+
+	REQUIRE(tracked.get_energy(0) > 0);
+	REQUIRE(tracked.get_energy(1) > 0);
+	REQUIRE(tracked.get_energy(3) > 0);
+
+	// in steady state the capacitor holds its energy, the resistors dissipate V^2/R per second,
+	// and the battery delivers what the resistors dissipate.
+	std::vector<double> before{};
+	for(std::size_t i{0}; i < plan.types.size(); i++){
+		before.push_back(tracked.get_energy(i));
+	}
+	for(int step = 0; step < steps; step++){
+		tracked.step();
+	}
+
+	const double elapsed{steps * static_cast<double>(time)};
+	const double delivered{tracked.get_energy(0) - before.at(0)};
+	const double dissipated1{tracked.get_energy(1) - before.at(1)};
+	const double dissipated2{tracked.get_energy(2) - before.at(2)};
+	REQUIRE(dissipated1 == Approx(elapsed * 14.4 * 14.4 / 6).epsilon(0.01));
+	REQUIRE(dissipated2 == Approx(elapsed * 9.6 * 9.6 / 4).epsilon(0.01));
+	REQUIRE(delivered == Approx(dissipated1 + dissipated2).epsilon(0.01));
+	REQUIRE(tracked.get_energy(3) == Approx(before.at(3)));
+}
+
+TEST_CASE("FlatCircuit: Test printing"){
+	std::istringstream text{"Battery Bat 24 P N\nResistor R1 6 P L\nCapacitor C2 0.5 L N\n"};
+	const CircuitPlan plan{Netlist{text}.compile()};
+
+	Component::time_step = 0.01;
+	NetlistCircuit reference{plan};
+	FlatCircuit flat{plan, 0.01, true};
+	for(int step = 0; step < 100; step++){
+		reference.get_circuit().step();
+		flat.step();
+	}
+
+	// the same table as Circuit
+	std::ostringstream expected{};
+	reference.get_circuit().print_titles(expected);
+	reference.get_circuit().step_print(expected);
+	std::ostringstream printed{};
+	flat.print_titles(printed);
+	flat.step_print(printed);
+	REQUIRE(printed.str() == expected.str());
+
+	std::ostringstream energies{};
+	flat.print_energies(energies);
+	std::istringstream values{energies.str()};
+	for(std::size_t i{0}; i < flat.size(); i++){
+		double energy{};
+		REQUIRE(values >> energy);
+		REQUIRE(energy == Approx(flat.get_energy(i)).margin(0.005));
+	}
+	REQUIRE(energies.str().size() == 12 * flat.size() + 1);
+}
+
+// ------------ DIFFERENTIAL TESTS ----------
+TEST_CASE("FlatCircuit: Identical results to Circuit on random circuits"){
+	int completed{0};
+	int refused{0};
+
+	for(unsigned seed{1}; seed <= 50; seed++){
+		const int num_nodes{3 + static_cast<int>(seed % 30)};
+		const Netlist netlist{random_netlist(seed, num_nodes, 2 * num_nodes, true)};
+
+		const Divergence divergence{compare(netlist, 500, 0.01)};
+		INFO("seed " << seed << ": " << divergence.steps_compared << " steps compared, first diverging step "
+			 << divergence.first_step << ", max error " << divergence.max_error);
+		REQUIRE(divergence.first_step == -1);
+		REQUIRE(divergence.max_error == 0);
+		// both circuits refuse the same charge at the same step
+		REQUIRE(divergence.flat_error == divergence.reference_error);
+
+		completed += divergence.steps_compared == 500;
+		refused += !divergence.reference_error.empty();
+	}
+
+	INFO(completed << " of 50 random circuits compared for all steps, " << refused << " refused a charge");
+	REQUIRE(completed >= 35);
+	REQUIRE(completed + refused == 50);
+}
+
+// hidden, run with `SimulatorTest [.benchmark]`
+TEST_CASE("FlatCircuit: Throughput compared to Circuit", "[.benchmark]"){
+	const Netlist netlist{random_netlist(42, 1000, 4000, false)};
+	const CircuitPlan plan{netlist.compile()};
+
+	Component::time_step = 0.01;
+	NetlistCircuit reference{plan};
+	FlatCircuit flat{plan, 0.01};
+
+	for(int step = 0; step < 200; step++){
+		reference.get_circuit().step();
+		flat.step();
+	}
+	REQUIRE(flat.get_voltage(1) == reference.get_circuit().get_list().at(1)->get_voltage());
+
+	INFO("one step of " << plan.types.size() << " components");
+	BENCHMARK("Circuit"){
+		reference.get_circuit().step();
+	};
+	BENCHMARK("FlatCircuit"){
+		flat.step();
+	};
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,261 @@
+/**
+ * netlist.cpp
+ * -----------
+ * Description:
+ *
+ * 	----- Netlists -----
+ *
+ * 	A netlist is a textual description of a circuit network, so that circuits can be
+ * 	sent to the simulator instead of being written in C++. Each line describes one
+ * 	component by its type, name, value and the names of the connection points on its
+ * 	two terminals. Empty lines and lines starting with `#` are ignored.
+ *
+ * Example netlist:
+ * 	Battery Bat 24 P N
+ * 	Resistor R1 6 P R124
+ * 	Capacitor C3 1.0 R124 N
+ *
+ * 	The connection points are numbered in order of first appearance.
+ *
+ * 	Before being simulated, a netlist is compiled into a CircuitPlan, which stores
+ * 	the components as parallel arrays of types, values and connection point indices,
+ * 	so that the names only have to be resolved once per netlist.
+ *
+ * 	*/
+
+#include <sstream>
+#include <stdexcept>
+#include "netlist.hpp"
+
+namespace {
+	// 64-bit FNV-1a hash of a text.
+	std::uint64_t fnv1a(const std::string& text){
+		std::uint64_t hash{14695981039346656037ull};
+		for(const char c : text){
+			hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+		}
+
+		return hash;
+	}
+}
+
+/**
+ * Class Netlist:
+ * 	This class represents a parsed netlist, i.e. a list of component descriptions
+ * 	and the names of the connection points between them.
+ *
+ */
+
+/**
+ * @brief Initializing an empty netlist.
+ *
+ */
+Netlist::Netlist()
+	: _components{}, _nodes{}, _node_indices{}
+	{}
+
+/**
+ * @brief Initializing a netlist by parsing it from a stream.
+ *
+ * @param is: input stream containing one component per line.
+ * @throws std::invalid_argument if a line cannot be parsed.
+ *
+ */
+Netlist::Netlist(std::istream& is)
+	: _components{}, _nodes{}, _node_indices{}
+{
+	std::string line{};
+	int line_number{0};
+
+	while(std::getline(is, line)){
+		line_number++;
+		std::istringstream iss{line};
+		ComponentSpec spec{};
+
+		if(!(iss >> spec.type) || spec.type.starts_with('#')){
+			continue;
+		}
+
+		if(!(iss >> spec.name >> spec.value >> spec.terminal_a >> spec.terminal_b)){
+			throw std::invalid_argument("Line " + std::to_string(line_number) + ": Expected "
+										"`<type> <name> <value> <terminal> <terminal>`.");
+		}
+
+		add_component(spec);
+	}
+}
+
+/**
+ * @brief Adding a component description to the netlist.
+ *
+ * @param spec: description of the component.
+ * @throws std::invalid_argument if the type is unknown or the value is not positive.
+ *
+ */
+void Netlist::add_component(const ComponentSpec& spec){
+	if(spec.type != "Battery" && spec.type != "Resistor" && spec.type != "Capacitor"){
+		throw std::invalid_argument("Unknown component type `" + spec.type + "`.");
+	}
+
+	if(spec.value <= 0){
+		throw std::invalid_argument("Value of `" + spec.name + "` must be positive.");
+	}
+
+	_add_node(spec.terminal_a);
+	_add_node(spec.terminal_b);
+	_components.push_back(spec);
+}
+
+const std::vector<ComponentSpec>& Netlist::get_components() const{
+	return _components;
+}
+
+const std::vector<std::string>& Netlist::get_nodes() const{
+	return _nodes;
+}
+
+/**
+ * @brief Getting the index of a connection point.
+ *
+ * @param node: name of the connection point.
+ * @return the index of the connection point.
+ * @throws std::invalid_argument if there is no such connection point.
+ *
+ */
+std::size_t Netlist::node_index(const std::string& node) const{
+	const auto it{_node_indices.find(node)};
+
+	if(it == _node_indices.end()){
+		throw std::invalid_argument("Unknown connection point `" + node + "`.");
+	}
+
+	return it->second;
+}
+
+/**
+ * @brief Getting the canonical text of the netlist.
+ *
+ * One line per component, with single spaces and values in hexadecimal floating
+ * point, so that two netlists describing the same components in the same order
+ * have the same text, regardless of whitespace and comments.
+ *
+ * @return the text.
+ *
+ */
+std::string Netlist::text() const{
+	std::ostringstream oss{};
+	oss << std::hexfloat;
+	for(const ComponentSpec& spec : _components){
+		oss << spec.type << ' ' << spec.name << ' ' << spec.value << ' '
+			<< spec.terminal_a << ' ' << spec.terminal_b << '\n';
+	}
+
+	return oss.str();
+}
+
+/**
+ * @brief Getting a hash of the netlist.
+ *
+ * The hash of the canonical text of the netlist, computed with 64-bit FNV-1a, so it
+ * is the same across builds and can be used to name files.
+ *
+ * @return the hash.
+ *
+ */
+std::uint64_t Netlist::hash() const{
+	return fnv1a(text());
+}
+
+/**
+ * @brief Compiling the netlist into a plan.
+ *
+ * @return the plan, with one entry per component in each of its arrays.
+ *
+ */
+CircuitPlan Netlist::compile() const{
+	std::string netlist_text{text()};
+	const std::uint64_t netlist_hash{fnv1a(netlist_text)};
+	CircuitPlan plan{netlist_hash, _nodes.size(), {}, {}, {}, {}, {}, std::move(netlist_text)};
+	for(const ComponentSpec& spec : _components){
+		plan.names.push_back(spec.name);
+		plan.values.push_back(spec.value);
+		plan.terminals_a.push_back(static_cast<std::uint32_t>(_node_indices.at(spec.terminal_a)));
+		plan.terminals_b.push_back(static_cast<std::uint32_t>(_node_indices.at(spec.terminal_b)));
+
+		if(spec.type == "Battery"){
+			plan.types.push_back(ComponentType::battery);
+		}
+		else if(spec.type == "Resistor"){
+			plan.types.push_back(ComponentType::resistor);
+		}
+		else{
+			plan.types.push_back(ComponentType::capacitor);
+		}
+	}
+
+	return plan;
+}
+
+void Netlist::_add_node(const std::string& node){
+	if(_node_indices.try_emplace(node, _nodes.size()).second){
+		_nodes.push_back(node);
+	}
+}
+
+/**
+ * Class NetlistCircuit:
+ * 	This class represents a circuit network built from a netlist. It owns both the
+ * 	connection points and the circuit, so that it can be simulated on its own.
+ *
+ */
+
+/**
+ * @brief Building a circuit from a netlist.
+ *
+ * @param netlist: the description of the circuit.
+ *
+ */
+NetlistCircuit::NetlistCircuit(const Netlist& netlist)
+	: NetlistCircuit(netlist.compile())
+	{}
+
+/**
+ * @brief Building a circuit from a compiled netlist.
+ *
+ * @param plan: the compiled description of the circuit.
+ * @throws std::invalid_argument if a component has an unknown type.
+ *
+ */
+NetlistCircuit::NetlistCircuit(const CircuitPlan& plan)
+	: _connections(plan.num_nodes), _circuit{}
+{
+	for(std::size_t i{0}; i < plan.types.size(); i++){
+		Connection& a{_connections.at(plan.terminals_a.at(i))};
+		Connection& b{_connections.at(plan.terminals_b.at(i))};
+
+		switch(plan.types.at(i)){
+			case ComponentType::battery:
+				_circuit.add_component(new Battery(plan.names.at(i), plan.values.at(i), a, b));
+				break;
+			case ComponentType::resistor:
+				_circuit.add_component(new Resistor(plan.names.at(i), plan.values.at(i), a, b));
+				break;
+			case ComponentType::capacitor:
+				_circuit.add_component(new Capacitor(plan.names.at(i), plan.values.at(i), a, b));
+				break;
+			default:
+				throw std::invalid_argument("Unknown component type " +
+											std::to_string(static_cast<int>(plan.types.at(i))) + ".");
+		}
+	}
+}
+
+Circuit& NetlistCircuit::get_circuit(){
+	return _circuit;
+}
+
+Connection& NetlistCircuit::get_connection(std::size_t index){
+	return _connections.at(index);
+}
+
+// ============== END OF FILE ==============
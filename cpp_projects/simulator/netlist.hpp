@@ -0,0 +1,95 @@
+/**
+ * netlist.hpp
+ * -----------
+ * Description:
+ * 	Header file containing declarations for textual circuit descriptions (netlists).
+ * */
+
+#ifndef NETLIST_HPP
+#define NETLIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "circuit.hpp"
+
+enum class ComponentType : std::uint8_t{
+	battery,
+	resistor,
+	capacitor
+};
+
+struct ComponentSpec{
+	std::string type;
+	std::string name;
+	double value;
+	std::string terminal_a;
+	std::string terminal_b;
+};
+
+struct CircuitPlan{
+	std::uint64_t hash;
+	std::size_t num_nodes;
+	std::vector<std::string> names;
+	std::vector<ComponentType> types;
+	std::vector<double> values;
+	std::vector<std::uint32_t> terminals_a;
+	std::vector<std::uint32_t> terminals_b;
+	// the canonical text of the netlist, which tells netlists with the same hash apart.
+	std::string text;
+};
+
+class Netlist{
+public:
+	Netlist();
+
+	explicit Netlist(std::istream& is);
+
+	void add_component(const ComponentSpec& spec);
+
+	const std::vector<ComponentSpec>& get_components() const;
+
+	const std::vector<std::string>& get_nodes() const;
+
+	std::size_t node_index(const std::string& node) const;
+
+	std::string text() const;
+
+	std::uint64_t hash() const;
+
+	CircuitPlan compile() const;
+
+private:
+	std::vector<ComponentSpec> _components;
+	std::vector<std::string> _nodes;
+	// the index of each connection point in _nodes.
+	std::unordered_map<std::string, std::size_t> _node_indices;
+
+	void _add_node(const std::string& node);
+};
+
+class NetlistCircuit{
+public:
+	explicit NetlistCircuit(const Netlist& netlist);
+
+	explicit NetlistCircuit(const CircuitPlan& plan);
+
+	NetlistCircuit(const NetlistCircuit&) = delete;
+	NetlistCircuit& operator=(const NetlistCircuit&) = delete;
+
+	Circuit& get_circuit();
+
+	Connection& get_connection(std::size_t index);
+
+private:
+	std::deque<Connection> _connections;
+	Circuit _circuit;
+};
+
+#endif // NETLIST_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,96 @@
+#include "netlist.hpp"
+#include "../../test/catch.hpp"
+#include <sstream>
+
+// -------------- UNIT TESTS --------------
+
+// --- Class Netlist ---
+TEST_CASE("Netlist: Test parsing"){
+	// empty netlist
+	std::istringstream empty{""};
+	Netlist n0{empty};
+	REQUIRE(n0.get_components().size() == 0);
+	REQUIRE(n0.get_nodes().size() == 0);
+
+	// comments and empty lines are ignored, nodes numbered by first appearance
+	std::istringstream text{"# two resistors\n\nBattery Bat 24 P N\nResistor R1 6 P L\n  Resistor R2 4 L N\n"};
+	Netlist n1{text};
+	REQUIRE(n1.get_components().size() == 3);
+	REQUIRE(n1.get_components().at(1).name == "R1");
+	REQUIRE(n1.get_components().at(1).value == 6);
+	REQUIRE(n1.get_nodes() == std::vector<std::string>{"P", "N", "L"});
+	REQUIRE(n1.node_index("L") == 2);
+	REQUIRE_THROWS_WITH(n1.node_index("X"), "Unknown connection point `X`.");
+
+	// invalid lines
+	std::istringstream missing{"Battery Bat 24 P\n"};
+	REQUIRE_THROWS_WITH(Netlist{missing}, "Line 1: Expected `<type> <name> <value> <terminal> <terminal>`.");
+	std::istringstream unknown{"\nDiode D1 1 P N\n"};
+	REQUIRE_THROWS_WITH(Netlist{unknown}, "Unknown component type `Diode`.");
+	std::istringstream negative{"Resistor R1 -6 P N\n"};
+	REQUIRE_THROWS_WITH(Netlist{negative}, "Value of `R1` must be positive.");
+}
+
+TEST_CASE("Netlist: Test hash"){
+	std::istringstream text1{"Battery Bat 24 P N\nResistor R1 6 P N\n"};
+	std::istringstream text2{"# same circuit\nBattery   Bat 24.0 P N\n\nResistor R1 6 P N"};
+	std::istringstream text3{"Battery Bat 24 P N\nResistor R1 7 P N\n"};
+
+	const Netlist netlist1{text1};
+	const Netlist netlist2{text2};
+	REQUIRE(netlist1.hash() == netlist2.hash());
+	REQUIRE(netlist1.text() == netlist2.text());
+	REQUIRE(netlist1.text() == "Battery Bat 0x1.8p+4 P N\nResistor R1 0x1.8p+2 P N\n");
+	REQUIRE(netlist1.compile().text == netlist1.text());
+	REQUIRE(netlist1.hash() != Netlist{text3}.hash());
+}
+
+// --- Class NetlistCircuit ---
+TEST_CASE("NetlistCircuit: Identical results to Circuit"){
+	int steps{20000};
+	Component::time_step = 0.01;
+
+	std::istringstream text{"Battery Bat 24 P N\nResistor R1 150 P L\nResistor R2 50 P R\n"
+							"Capacitor C3 1.0 L R\nResistor R4 300 L N\nCapacitor C5 0.75 R N\n"};
+	Netlist netlist{text};
+	NetlistCircuit built{netlist};
+
+	Circuit circuit{};
+	Connection P, N, R, L;
+
+	circuit.add_component(new Battery("Bat", 24, P, N));
+	circuit.add_component(new Resistor("R1", 150, P, L));
+	circuit.add_component(new Resistor("R2", 50, P, R));
+	circuit.add_component(new Capacitor("C3", 1.0, L, R));
+	circuit.add_component(new Resistor("R4", 300, L, N));
+	circuit.add_component(new Capacitor("C5", 0.75, R, N));
+
+	for(int step = 0; step < steps; step++){
+		circuit.step();
+		built.get_circuit().step();
+	}
+
+	std::vector<Component*> const& expected{circuit.get_list()};
+	std::vector<Component*> const& list{built.get_circuit().get_list()};
+	REQUIRE(list.size() == expected.size());
+	for(std::size_t i{0}; i < list.size(); i++){
+		REQUIRE(list.at(i)->get_name() == expected.at(i)->get_name());
+		REQUIRE(list.at(i)->get_voltage() == expected.at(i)->get_voltage());
+		REQUIRE(list.at(i)->get_current() == expected.at(i)->get_current());
+	}
+	REQUIRE(built.get_connection(netlist.node_index("L")).get_charge() == L.get_charge());
+
+	std::ostringstream oss{};
+	built.get_circuit().print_titles(oss);
+	REQUIRE(oss.str().starts_with("         Bat          R1"));
+}
+
+TEST_CASE("NetlistCircuit: Test unknown component type"){
+	std::istringstream text{"Battery Bat 24 P N\nResistor R1 6 P N\n"};
+	CircuitPlan plan{Netlist{text}.compile()};
+	plan.types.at(1) = static_cast<ComponentType>(7);
+
+	REQUIRE_THROWS_WITH(NetlistCircuit{plan}, "Unknown component type 7.");
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,77 @@
+/**
+ * networks.hpp
+ * ------------
+ * Description:
+ * 	Header-only definitions of the three circuit networks simulated by simulate.cpp,
+ * 	as StaticCircuit types. Each network has a function building it with a time step
+ * 	and a battery voltage, and the names of its components for printing.
+ *
+ * 	The connection points are numbered P = 0 and N = 1, the positive and negative
+ * 	terminals of the battery, followed by the inner connection points.
+ *
+ * */
+
+#ifndef NETWORKS_HPP
+#define NETWORKS_HPP
+
+#include <array>
+#include <string_view>
+#include "static_circuit.hpp"
+
+// connection points: P = 0, N = 1, R23 = 2, R124 = 3
+using FourResistorsNetwork = StaticCircuit<4, StaticBattery<0, 1>, StaticResistor<0, 3>, StaticResistor<3, 2>,
+										   StaticResistor<2, 1>, StaticResistor<3, 1>>;
+
+inline constexpr std::array<std::string_view, 5> four_resistors_names{"Bat", "R1", "R2", "R3", "R4"};
+
+/**
+ * @brief Building a battery with four resistors, where R1 is in series with R2 + R3 and R4 in parallel.
+ *
+ * @param time_step: the step size used for time, in seconds.
+ * @param voltage: the battery voltage.
+ * @return the circuit, where all connection points have zero charge.
+ *
+ */
+inline FourResistorsNetwork four_resistors_network(float time_step, double voltage){
+	return {time_step, {voltage}, {6}, {4}, {8}, {12}};
+}
+
+// connection points: P = 0, N = 1, L = 2, R = 3
+using FiveResistorsNetwork = StaticCircuit<4, StaticBattery<0, 1>, StaticResistor<0, 2>, StaticResistor<0, 3>,
+										   StaticResistor<2, 3>, StaticResistor<2, 1>, StaticResistor<3, 1>>;
+
+inline constexpr std::array<std::string_view, 6> five_resistors_names{"Bat", "R1", "R2", "R3", "R4", "R5"};
+
+/**
+ * @brief Building a battery with five resistors in a bridge, where R3 connects its two sides.
+ *
+ * @param time_step: the step size used for time, in seconds.
+ * @param voltage: the battery voltage.
+ * @return the circuit, where all connection points have zero charge.
+ *
+ */
+inline FiveResistorsNetwork five_resistors_network(float time_step, double voltage){
+	return {time_step, {voltage}, {150}, {50}, {100}, {300}, {250}};
+}
+
+// connection points: P = 0, N = 1, L = 2, R = 3
+using CapacitorsNetwork = StaticCircuit<4, StaticBattery<0, 1>, StaticResistor<0, 2>, StaticResistor<0, 3>,
+										StaticCapacitor<2, 3>, StaticResistor<2, 1>, StaticCapacitor<3, 1>>;
+
+inline constexpr std::array<std::string_view, 6> capacitors_names{"Bat", "R1", "R2", "C3", "R4", "C5"};
+
+/**
+ * @brief Building the bridge of five_resistors_network where R3 and R5 are replaced by capacitors.
+ *
+ * @param time_step: the step size used for time, in seconds.
+ * @param voltage: the battery voltage.
+ * @return the circuit, where all connection points have zero charge.
+ *
+ */
+inline CapacitorsNetwork capacitors_network(float time_step, double voltage){
+	return {time_step, {voltage}, {150}, {50}, {1.0}, {300}, {0.75}};
+}
+
+#endif // NETWORKS_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,346 @@
+/**
+ * plan_cache.cpp
+ * --------------
+ * Description:
+ *
+ * 	----- Plan Cache -----
+ *
+ * 	Compiling a netlist into a CircuitPlan resolves the connection point names and
+ * 	lays out the components as parallel arrays. Many runs use the same netlist, so
+ * 	the plans are cached by the hash of the netlist, which covers both the topology
+ * 	and the component values. The canonical text of the netlist is kept with its
+ * 	plan, so that a different netlist with the same hash is refused instead of being
+ * 	given the wrong plan. Every plan also has a FlatCircuit that is ready to step,
+ * 	which runs copy instead of building their circuit from the plan.
+ *
+ * 	Optionally the cache is backed by a directory, where each plan is stored in a
+ * 	file named after its hash. The file is a fixed header followed by the arrays of
+ * 	the plan, each one aligned to its element size, so that it can be memory-mapped
+ * 	and read without any parsing:
+ *
+ * 	| "CIRPLAN2" | hash | nodes | components | names size | text size |   (6 x 8 bytes)
+ * 	| values (double) | terminals A (uint32) | terminals B (uint32) | types (uint8) |
+ * 	| names, each terminated by '\0' | text of the netlist |
+ *
+ * 	A plan file is checked when it is loaded: the sizes must match the file, every
+ * 	type must be known, every terminal must be a connection point, every value must
+ * 	be positive, and every name must end within the names.
+ *
+ * 	*/
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include "plan_cache.hpp"
+
+namespace {
+	constexpr std::array<char, 8> magic{'C', 'I', 'R', 'P', 'L', 'A', 'N', '2'};
+
+	struct PlanHeader{
+		std::array<char, 8> magic;
+		std::uint64_t hash;
+		std::uint64_t num_nodes;
+		std::uint64_t num_components;
+		std::uint64_t names_size;
+		std::uint64_t text_size;
+	};
+
+	// whether a plan file of `size` bytes has the given header, checking the sizes before they are multiplied.
+	bool matches_size(const PlanHeader& header, std::size_t size){
+		constexpr std::size_t component_size{sizeof(double) + 2 * sizeof(std::uint32_t) + sizeof(ComponentType)};
+		return header.magic == magic && header.num_components <= size && header.names_size <= size &&
+			   header.text_size <= size && header.num_nodes <= std::numeric_limits<std::uint32_t>::max() &&
+			   size == sizeof(PlanHeader) + header.num_components * component_size + header.names_size +
+					   header.text_size;
+	}
+
+	template<typename T>
+	void write_array(std::ofstream& file, const std::vector<T>& array){
+		file.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+	}
+
+	// the array of `size` elements at `data` in a mapped plan, whose offset is aligned to the element size.
+	template<typename T>
+	std::span<const T> mapped_array(const char*& data, std::size_t size){
+		const std::span<const T> array{reinterpret_cast<const T*>(data), size};
+		data += size * sizeof(T);
+		return array;
+	}
+
+	/**
+	 * @brief Building a plan from a mapped plan file, checking it on the way.
+	 *
+	 * @param data: the mapped file, whose sizes match its header.
+	 * @param size: size of the file.
+	 * @param path: path of the file, for errors.
+	 * @return the plan.
+	 * @throws std::runtime_error if the file is not a valid plan.
+	 */
+	CircuitPlan read_plan(const char* data, std::size_t size, const std::filesystem::path& path){
+		const char* const end{data + size};
+		PlanHeader header{};
+		std::memcpy(&header, data, sizeof(header));
+		data += sizeof(header);
+
+		const auto values{mapped_array<double>(data, header.num_components)};
+		const auto terminals_a{mapped_array<std::uint32_t>(data, header.num_components)};
+		const auto terminals_b{mapped_array<std::uint32_t>(data, header.num_components)};
+		const auto types{mapped_array<ComponentType>(data, header.num_components)};
+
+		const auto invalid{[&path]{
+			return std::runtime_error("Invalid plan `" + path.string() + "`.");
+		}};
+
+		for(std::size_t i{0}; i < header.num_components; i++){
+			if(static_cast<std::uint8_t>(types[i]) > static_cast<std::uint8_t>(ComponentType::capacitor) ||
+			   terminals_a[i] >= header.num_nodes || terminals_b[i] >= header.num_nodes || !(values[i] > 0)){
+				throw invalid();
+			}
+		}
+
+		CircuitPlan plan{header.hash, header.num_nodes, {}, {types.begin(), types.end()},
+						 {values.begin(), values.end()}, {terminals_a.begin(), terminals_a.end()},
+						 {terminals_b.begin(), terminals_b.end()}, {}};
+
+		// every name must end within the names, which must hold exactly the names
+		const char* const names_end{data + header.names_size};
+		plan.names.reserve(header.num_components);
+		for(std::uint64_t i{0}; i < header.num_components; i++){
+			const void* const terminator{std::memchr(data, '\0', names_end - data)};
+			if(terminator == nullptr){
+				throw invalid();
+			}
+			plan.names.emplace_back(data, static_cast<const char*>(terminator));
+			data = static_cast<const char*>(terminator) + 1;
+		}
+		if(data != names_end){
+			throw invalid();
+		}
+
+		plan.text.assign(data, end);
+		return plan;
+	}
+}
+
+/**
+ * @brief Saving a plan to a file.
+ *
+ * The plan is first written to a temporary file of the calling thread which is then
+ * renamed, so that a partially written plan is never read.
+ *
+ * @param plan: the plan to save.
+ * @param path: path of the file.
+ * @throws std::runtime_error if the file cannot be written.
+ *
+ */
+void save_plan(const CircuitPlan& plan, const std::filesystem::path& path){
+	std::string names{};
+	for(const std::string& name : plan.names){
+		names += name + '\0';
+	}
+
+	const PlanHeader header{magic, plan.hash, plan.num_nodes, plan.types.size(), names.size(), plan.text.size()};
+	std::filesystem::path temporary{path};
+	temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+	{
+		std::ofstream file{temporary, std::ios::binary};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		write_array(file, plan.values);
+		write_array(file, plan.terminals_a);
+		write_array(file, plan.terminals_b);
+		write_array(file, plan.types);
+		file.write(names.data(), names.size());
+		file.write(plan.text.data(), plan.text.size());
+
+		if(!file){
+			throw std::runtime_error("Cannot write plan to `" + temporary.string() + "`.");
+		}
+	}
+
+	std::filesystem::rename(temporary, path);
+}
+
+/**
+ * @brief Loading a plan from a file.
+ *
+ * The file is memory-mapped, checked, and the plan is built from its arrays in place.
+ *
+ * @param path: path of the file.
+ * @return the plan.
+ * @throws std::runtime_error if the file cannot be read or is not a valid plan.
+ *
+ */
+CircuitPlan load_plan(const std::filesystem::path& path){
+	const int fd{open(path.c_str(), O_RDONLY)};
+	struct stat info{};
+
+	if(fd < 0 || fstat(fd, &info) < 0){
+		if(fd >= 0){
+			close(fd);
+		}
+		throw std::runtime_error("Cannot open plan `" + path.string() + "`.");
+	}
+
+	const std::size_t size{static_cast<std::size_t>(info.st_size)};
+	void* mapping{size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED};
+	close(fd);
+
+	if(mapping == MAP_FAILED){
+		throw std::runtime_error("Cannot map plan `" + path.string() + "`.");
+	}
+
+	const char* data{static_cast<const char*>(mapping)};
+	PlanHeader header{};
+	if(size >= sizeof(header)){
+		std::memcpy(&header, data, sizeof(header));
+	}
+
+	if(size < sizeof(header) || !matches_size(header, size)){
+		munmap(mapping, size);
+		throw std::runtime_error("Invalid plan `" + path.string() + "`.");
+	}
+
+	try{
+		CircuitPlan plan{read_plan(data, size, path)};
+		munmap(mapping, size);
+		return plan;
+	}
+	catch(...){
+		munmap(mapping, size);
+		throw;
+	}
+}
+
+/**
+ * Class PlanCache:
+ * 	This class represents a thread-safe cache of compiled netlists, keyed by the
+ * 	hash of the netlist and optionally backed by a directory.
+ *
+ */
+
+/**
+ * @brief Initializing an empty cache.
+ *
+ * @param directory: directory where plans are stored, by default plans are only kept in memory.
+ *
+ */
+PlanCache::PlanCache(std::filesystem::path directory)
+	: _mutex{}, _plans{}, _directory{std::move(directory)}
+{
+	if(!_directory.empty()){
+		std::filesystem::create_directories(_directory);
+	}
+}
+
+/**
+ * @brief Getting the plan of a netlist, compiling it only if it is not cached.
+ *
+ * A file of the plan that is not valid, such as one of an older format, is replaced.
+ *
+ * @param netlist: the netlist.
+ * @return the plan.
+ * @throws std::invalid_argument if a different netlist with the same hash is cached.
+ *
+ */
+std::shared_ptr<const CircuitPlan> PlanCache::compile(const Netlist& netlist){
+	const auto plan{std::make_shared<const CircuitPlan>(netlist.compile())};
+
+	std::shared_ptr<const CircuitPlan> cached{};
+	try{
+		cached = find(plan->hash);
+	}
+	catch(std::runtime_error&){
+		// an invalid file, such as a plan of an older format, is replaced below
+	}
+
+	if(!cached){
+		if(!_directory.empty()){
+			save_plan(*plan, _path(plan->hash));
+		}
+		cached = _insert(plan).plan;
+	}
+
+	// the cached plan may be of another netlist, even one cached by another thread meanwhile
+	if(cached->text != plan->text){
+		throw std::invalid_argument("Another netlist with the hash " + std::to_string(plan->hash) + " is cached.");
+	}
+
+	return cached;
+}
+
+/**
+ * @brief Finding a plan by its hash, first in memory and then on disk.
+ *
+ * @param hash: hash of the netlist.
+ * @return the plan, or a null pointer if there is no such plan.
+ * @throws std::runtime_error if the file of the plan is not a valid plan of that hash.
+ *
+ */
+std::shared_ptr<const CircuitPlan> PlanCache::find(std::uint64_t hash){
+	return _find(hash).plan;
+}
+
+/**
+ * @brief Finding the circuit of a plan by its hash, ready to step.
+ *
+ * The circuit has all its connection points at zero charge and is shared, so a run
+ * copies it with its own time step (see FlatCircuit).
+ *
+ * @param hash: hash of the netlist.
+ * @return the circuit, or a null pointer if there is no such plan.
+ * @throws std::runtime_error if the file of the plan is not a valid plan of that hash.
+ *
+ */
+std::shared_ptr<const FlatCircuit> PlanCache::find_circuit(std::uint64_t hash){
+	return _find(hash).circuit;
+}
+
+// number of plans in memory
+std::size_t PlanCache::size() const{
+	std::lock_guard<std::mutex> lock{_mutex};
+	return _plans.size();
+}
+
+std::filesystem::path PlanCache::_path(std::uint64_t hash) const{
+	return _directory / (std::to_string(hash) + ".plan");
+}
+
+// the cached plan of a hash and its circuit, loading it from disk if needed, or null pointers.
+PlanCache::Entry PlanCache::_find(std::uint64_t hash){
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+		if(const auto it{_plans.find(hash)}; it != _plans.end()){
+			return it->second;
+		}
+	}
+
+	if(_directory.empty() || !std::filesystem::exists(_path(hash))){
+		return {};
+	}
+
+	auto plan{std::make_shared<const CircuitPlan>(load_plan(_path(hash)))};
+	if(plan->hash != hash){
+		throw std::runtime_error("Invalid plan `" + _path(hash).string() + "`.");
+	}
+
+	return _insert(std::move(plan));
+}
+
+// cache a plan with its circuit, unless another thread has cached the same hash first.
+PlanCache::Entry PlanCache::_insert(std::shared_ptr<const CircuitPlan> plan){
+	auto circuit{std::make_shared<const FlatCircuit>(*plan, 0.0f)};
+
+	std::lock_guard<std::mutex> lock{_mutex};
+	return _plans.try_emplace(plan->hash, Entry{plan, std::move(circuit)}).first->second;
+}
+
+// ============== END OF FILE ==============
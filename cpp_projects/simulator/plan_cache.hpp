@@ -0,0 +1,55 @@
+/**
+ * plan_cache.hpp
+ * --------------
+ * Description:
+ * 	Header file containing declarations for caching compiled netlists.
+ * */
+
+#ifndef PLAN_CACHE_HPP
+#define PLAN_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "flat_circuit.hpp"
+#include "netlist.hpp"
+
+void save_plan(const CircuitPlan& plan, const std::filesystem::path& path);
+
+CircuitPlan load_plan(const std::filesystem::path& path);
+
+class PlanCache{
+public:
+	explicit PlanCache(std::filesystem::path directory = {});
+
+	std::shared_ptr<const CircuitPlan> compile(const Netlist& netlist);
+
+	std::shared_ptr<const CircuitPlan> find(std::uint64_t hash);
+
+	std::shared_ptr<const FlatCircuit> find_circuit(std::uint64_t hash);
+
+	std::size_t size() const;
+
+private:
+	// a plan and its circuit, ready to step.
+	struct Entry{
+		std::shared_ptr<const CircuitPlan> plan;
+		std::shared_ptr<const FlatCircuit> circuit;
+	};
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::uint64_t, Entry> _plans;
+	std::filesystem::path _directory;
+
+	std::filesystem::path _path(std::uint64_t hash) const;
+
+	Entry _find(std::uint64_t hash);
+
+	Entry _insert(std::shared_ptr<const CircuitPlan> plan);
+};
+
+#endif // PLAN_CACHE_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,159 @@
+#include "plan_cache.hpp"
+#include "../../test/catch.hpp"
+#include <fstream>
+#include <sstream>
+
+// -------------- UNIT TESTS --------------
+
+namespace {
+	Netlist make_netlist(const std::string& text){
+		std::istringstream iss{text};
+		return Netlist{iss};
+	}
+}
+
+TEST_CASE("Netlist: Test compile"){
+	const Netlist netlist{make_netlist("Battery Bat 24 P N\nResistor R1 6 P L\nCapacitor C2 0.5 L N\n")};
+	const CircuitPlan plan{netlist.compile()};
+
+	REQUIRE(plan.hash == netlist.hash());
+	REQUIRE(plan.num_nodes == 3);
+	REQUIRE(plan.names == std::vector<std::string>{"Bat", "R1", "C2"});
+	REQUIRE(plan.types == std::vector<ComponentType>{ComponentType::battery, ComponentType::resistor,
+													 ComponentType::capacitor});
+	REQUIRE(plan.values == std::vector<double>{24, 6, 0.5});
+	REQUIRE(plan.terminals_a == std::vector<std::uint32_t>{0, 0, 2});
+	REQUIRE(plan.terminals_b == std::vector<std::uint32_t>{1, 2, 1});
+}
+
+TEST_CASE("PlanCache: Test save_plan() and load_plan() functions"){
+	const std::filesystem::path path{std::filesystem::temp_directory_path() / "plan_cache_test.plan"};
+	const CircuitPlan plan{make_netlist("Battery Bat 24 P N\nResistor R1 6 P L\nCapacitor C2 0.5 L N\n").compile()};
+
+	save_plan(plan, path);
+	const CircuitPlan loaded{load_plan(path)};
+	REQUIRE(loaded.hash == plan.hash);
+	REQUIRE(loaded.num_nodes == plan.num_nodes);
+	REQUIRE(loaded.names == plan.names);
+	REQUIRE(loaded.types == plan.types);
+	REQUIRE(loaded.values == plan.values);
+	REQUIRE(loaded.terminals_a == plan.terminals_a);
+	REQUIRE(loaded.terminals_b == plan.terminals_b);
+	REQUIRE(loaded.text == plan.text);
+
+	// files with an unknown type, a terminal out of range, a value that is not positive,
+	// or a name that does not end within the names, are rejected
+	const auto corrupt{[&path, &plan](std::streamoff offset, auto value){
+		save_plan(plan, path);
+		std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+		file.seekp(offset);
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}};
+	// 48 bytes of header, 3 values, 3 + 3 terminals, 3 types, then "Bat\0R1\0C2\0"
+	corrupt(48 + 24 + 24 + 1, std::uint8_t{3});
+	REQUIRE_THROWS_WITH(load_plan(path), "Invalid plan `" + path.string() + "`.");
+	corrupt(48 + 24 + 4, std::uint32_t{3});
+	REQUIRE_THROWS_WITH(load_plan(path), "Invalid plan `" + path.string() + "`.");
+	corrupt(48 + 8, -6.0);
+	REQUIRE_THROWS_WITH(load_plan(path), "Invalid plan `" + path.string() + "`.");
+	corrupt(48 + 24 + 24 + 3 + 9, 'x');
+	REQUIRE_THROWS_WITH(load_plan(path), "Invalid plan `" + path.string() + "`.");
+
+	// truncated or missing files are rejected
+	std::filesystem::resize_file(path, 20);
+	REQUIRE_THROWS_WITH(load_plan(path), "Invalid plan `" + path.string() + "`.");
+	std::filesystem::remove(path);
+	REQUIRE_THROWS_WITH(load_plan(path), "Cannot open plan `" + path.string() + "`.");
+}
+
+TEST_CASE("PlanCache: Test compile() and find() methods"){
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "plan_cache_test"};
+	std::filesystem::remove_all(directory);
+
+	const Netlist netlist{make_netlist("Battery Bat 24 P N\nResistor R1 6 P N\n")};
+
+	// in memory only
+	PlanCache memory{};
+	REQUIRE(memory.find(netlist.hash()) == nullptr);
+	const auto plan{memory.compile(netlist)};
+	REQUIRE(memory.size() == 1);
+	REQUIRE(memory.compile(netlist) == plan);
+	REQUIRE(memory.find(netlist.hash()) == plan);
+
+	// backed by a directory, a new cache finds the plans of the previous one
+	{
+		PlanCache disk{directory};
+		disk.compile(netlist);
+		REQUIRE(std::filesystem::exists(directory / (std::to_string(netlist.hash()) + ".plan")));
+	}
+	PlanCache disk{directory};
+	REQUIRE(disk.size() == 0);
+	const auto loaded{disk.find(netlist.hash())};
+	REQUIRE(loaded != nullptr);
+	REQUIRE(loaded->names == plan->names);
+	REQUIRE(disk.size() == 1);
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("PlanCache: Test netlists with the same hash"){
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "plan_cache_collision_test"};
+	std::filesystem::remove_all(directory);
+
+	const Netlist netlist{make_netlist("Battery Bat 24 P N\nResistor R1 6 P N\n")};
+	const Netlist other{make_netlist("Battery Bat 24 P N\nResistor R1 8 P N\n")};
+	{
+		PlanCache disk{directory};
+		disk.compile(netlist);
+	}
+	const std::filesystem::path file{directory / (std::to_string(netlist.hash()) + ".plan")};
+	const std::filesystem::path other_file{directory / (std::to_string(other.hash()) + ".plan")};
+
+	// a plan in the file of another hash is rejected, and replaced when its netlist is compiled
+	std::filesystem::copy_file(file, other_file);
+	REQUIRE_THROWS_WITH(PlanCache{directory}.find(other.hash()), "Invalid plan `" + other_file.string() + "`.");
+	REQUIRE(PlanCache{directory}.compile(other)->text == other.text());
+	REQUIRE(PlanCache{directory}.find(other.hash())->text == other.text());
+	std::filesystem::copy_file(file, other_file, std::filesystem::copy_options::overwrite_existing);
+
+	// the same plan as if both netlists had the same hash
+	{
+		const std::uint64_t hash{other.hash()};
+		std::fstream stream{other_file, std::ios::in | std::ios::out | std::ios::binary};
+		stream.seekp(8);
+		stream.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+	}
+	PlanCache disk{directory};
+	REQUIRE(disk.find(other.hash()) != nullptr);
+	REQUIRE_THROWS_WITH(disk.compile(other),
+						"Another netlist with the hash " + std::to_string(other.hash()) + " is cached.");
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("PlanCache: Test find_circuit() method"){
+	const Netlist netlist{make_netlist("Battery Bat 24 P N\nResistor R1 6 P L\nCapacitor C2 0.5 L N\n")};
+	PlanCache cache{};
+	REQUIRE(cache.find_circuit(netlist.hash()) == nullptr);
+
+	const auto plan{cache.compile(netlist)};
+	const auto ready{cache.find_circuit(netlist.hash())};
+	REQUIRE(ready != nullptr);
+	REQUIRE(cache.find_circuit(netlist.hash()) == ready);
+
+	// a copy of the ready circuit steps like a circuit built from the plan
+	FlatCircuit copy{*ready, 0.01, true};
+	FlatCircuit built{*plan, 0.01, true};
+	for(int step = 0; step < 1000; step++){
+		copy.step();
+		built.step();
+	}
+	for(std::size_t i{0}; i < plan->types.size(); i++){
+		REQUIRE(copy.get_voltage(i) == built.get_voltage(i));
+		REQUIRE(copy.get_current(i) == built.get_current(i));
+		REQUIRE(copy.get_energy(i) == built.get_energy(i));
+		REQUIRE(ready->get_voltage(i) == FlatCircuit{*plan, 0}.get_voltage(i));
+	}
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,407 @@
+/**
+ * server.cpp
+ * ----------
+ * Description:
+ *
+ * 	----- Simulation Server -----
+ * This file implements a long-lived simulator that listens on a Unix domain socket,
+ * so that circuits can be simulated without starting a new process for every run.
+ * Netlists (see netlist.cpp) are sent once, compiled and cached by their hash (see
+ * plan_cache.cpp) and then run any number of times. Every run starts from a copy of
+ * the cached FlatCircuit of the netlist, which steps exactly like Circuit. When a cache directory is given,
+ * compiled netlists are also kept on disk and survive restarts of the server.
+ * The requests of all clients are read by one thread, which waits on all sockets at
+ * once with poll, and only loading and running netlists is handed to a shared pool
+ * of worker threads, so that idle clients hold no worker. The requests of a client
+ * are answered one at a time and in order, and the results of a run are streamed
+ * back while it is simulated.
+ *
+ * The protocol is line based:
+ * 	`LOAD <n>` followed by <n> netlist lines, answered by `OK <hash>`.
+ * 	`RUN <hash> <steps> <lines> <time_step> [ENERGY]`, answered by the same table as
+ * 		simulate.out prints, followed by `END`. With `ENERGY` the table is followed
+ * 		by a line with the energy of every component, in joules, under its name.
+ * 	`QUIT` closes the connection.
+ * Any failing request is answered by `ERROR <reason>`. A request line longer than
+ * 64 KiB, or a LOAD without a count of at most 2^20 lines or of more than 16 MiB,
+ * is answered by an error and closes the connection.
+ *
+ * Example command:
+ * 	`./server.out /tmp/simulator.sock 4 /tmp/plans`
+ * 	`printf 'LOAD 2\nBattery B 24 P N\nResistor R 6 P N\n' | socat - UNIX-CONNECT:/tmp/simulator.sock`
+ *
+ * 	*/
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "flat_circuit.hpp"
+#include "plan_cache.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+	// compiled netlists, shared by all connections.
+	std::unique_ptr<PlanCache> cache{};
+
+	// longest request line, and most lines and bytes of a netlist, that a client can send.
+	constexpr std::size_t max_line_length{1 << 16};
+	constexpr int max_netlist_lines{1 << 20};
+	constexpr std::size_t max_netlist_size{1 << 24};
+
+	// what the polling thread knows of a client between two of its requests.
+	struct Client{
+		// bytes that have been received but not yet taken as lines.
+		std::string buffer{};
+		// netlist lines of a LOAD received so far, and how many are still expected.
+		std::string netlist{};
+		int netlist_lines{0};
+		// a request of the client is being answered by a worker.
+		bool busy{false};
+		// the client has disconnected, or is disconnected once its last answer is written.
+		bool closing{false};
+	};
+
+	/**
+	 * @brief Taking one line from the bytes received from a client.
+	 *
+	 * @param buffer: bytes that have been received but not yet returned as lines.
+	 * @param line: the line taken, without the newline.
+	 * @return false if no full line has been received.
+	 */
+	bool take_line(std::string& buffer, std::string& line){
+		const std::size_t pos{buffer.find('\n')};
+		if(pos == std::string::npos){
+			return false;
+		}
+
+		line = buffer.substr(0, pos);
+		buffer.erase(0, pos + 1);
+		return true;
+	}
+
+	// write everything to a socket, ignoring a client that has gone away.
+	void write_all(int fd, std::string_view data){
+		while(!data.empty()){
+			const ssize_t sent{send(fd, data.data(), data.size(), MSG_NOSIGNAL)};
+			if(sent <= 0){
+				return;
+			}
+			data.remove_prefix(sent);
+		}
+	}
+
+	/**
+	 * @brief Loading a netlist into the cache.
+	 *
+	 * @return the hash the netlist can be run by.
+	 */
+	std::uint64_t load(std::istream& is){
+		return cache->compile(Netlist{is})->hash;
+	}
+
+	/**
+	 * @brief Simulating a cached netlist, streaming the printed lines to a socket.
+	 *
+	 * @param energy: whether the energy of every component is printed after the table.
+	 * @throws std::invalid_argument if the netlist is unknown or the arguments are invalid.
+	 */
+	void run(int fd, std::uint64_t hash, int steps, int num_lines_to_print, float time_step, bool energy){
+		const std::shared_ptr<const FlatCircuit> ready{cache->find_circuit(hash)};
+		if(!ready){
+			throw std::invalid_argument("Unknown circuit " + std::to_string(hash) + ".");
+		}
+
+		if(num_lines_to_print <= 0 || num_lines_to_print > steps){
+			throw std::invalid_argument("Number of lines to print must be between 1 and the number of steps.");
+		}
+
+		const int print_step{steps / num_lines_to_print};
+		FlatCircuit circuit{*ready, time_step, energy};
+
+		std::ostringstream oss{};
+		circuit.print_titles(oss);
+		write_all(fd, oss.str());
+
+		for(int step = 0; step < steps; step++){
+			circuit.step();
+
+			if((step+1) % print_step == 0){
+				oss.str("");
+				circuit.step_print(oss);
+				oss << '\n';
+				write_all(fd, oss.str());
+			}
+		}
+
+		if(energy){
+			oss.str("");
+			circuit.print_energies(oss);
+			write_all(fd, oss.str());
+		}
+	}
+
+	// answer a request with what `respond` writes, or with the error it throws.
+	void answer(int fd, const std::function<void()>& respond){
+		try{
+			respond();
+		}
+		catch(std::exception& e){
+			write_all(fd, std::string{"ERROR "} + e.what() + '\n');
+		}
+	}
+
+	/**
+	 * @brief Handing the answer of a request of a client to the pool.
+	 *
+	 * When the answer is written, the number of the socket is written to `done`, which
+	 * wakes up the polling thread to take the next request of the client.
+	 *
+	 */
+	void submit(ThreadPool& pool, int done, int fd, Client& client, std::function<void()> respond){
+		client.busy = true;
+		pool.submit([done, fd, respond = std::move(respond)]{
+			answer(fd, respond);
+			// writes of at most PIPE_BUF bytes to a pipe are never interleaved
+			[[maybe_unused]] const ssize_t written{write(done, &fd, sizeof(fd))};
+		});
+	}
+
+	// answer a request with an error, and disconnect the client once it is written.
+	void refuse(ThreadPool& pool, int done, int fd, Client& client, const std::string& reason){
+		client.closing = true;
+		client.buffer.clear();
+		submit(pool, done, fd, client, [reason]{ throw std::invalid_argument(reason); });
+	}
+
+	/**
+	 * @brief Turning the lines received from a client into requests, while none is being answered.
+	 *
+	 * LOAD and RUN are answered by the pool. The lines after them stay in the buffer
+	 * until their answer is written, so the answers of a client are written in order.
+	 *
+	 * @return false if the client is done and its socket has been closed.
+	 */
+	bool dispatch(ThreadPool& pool, int done, int fd, Client& client){
+		std::string line{};
+
+		while(!client.busy){
+			if(!take_line(client.buffer, line)){
+				if(client.buffer.size() > max_line_length){
+					refuse(pool, done, fd, client, "Line longer than " + std::to_string(max_line_length) + " bytes.");
+				}
+				else if(client.closing){
+					close(fd);
+					return false;
+				}
+				return true;
+			}
+
+			if(client.netlist_lines > 0){
+				client.netlist += line + '\n';
+				if(client.netlist.size() > max_netlist_size){
+					refuse(pool, done, fd, client,
+						   "Netlist larger than " + std::to_string(max_netlist_size) + " bytes.");
+				}
+				else if(--client.netlist_lines == 0){
+					submit(pool, done, fd, client, [fd, netlist = std::move(client.netlist)]{
+						std::istringstream netlist_stream{netlist};
+						write_all(fd, "OK " + std::to_string(load(netlist_stream)) + '\n');
+					});
+					client.netlist.clear();
+				}
+				continue;
+			}
+
+			std::istringstream request{line};
+			std::string command{};
+			request >> command;
+
+			if(command == "QUIT"){
+				close(fd);
+				return false;
+			}
+			else if(command == "LOAD"){
+				int count{0};
+
+				// a count that is missing, not a number or followed by more is refused like one out of range.
+				if(!(request >> count) || !(request >> std::ws).eof() || count < 0 || count > max_netlist_lines){
+					refuse(pool, done, fd, client,
+						   "Number of netlist lines must be between 0 and " + std::to_string(max_netlist_lines) + ".");
+				}
+				else if(count == 0){
+					submit(pool, done, fd, client, [fd]{
+						std::istringstream netlist_stream{};
+						write_all(fd, "OK " + std::to_string(load(netlist_stream)) + '\n');
+					});
+				}
+				else{
+					client.netlist_lines = count;
+				}
+			}
+			else if(command == "RUN"){
+				submit(pool, done, fd, client, [fd, line]{
+					std::istringstream request{line};
+					std::string command{};
+					std::uint64_t hash{};
+					int steps{};
+					int num_lines_to_print{};
+					float time_step{};
+					std::string option{};
+
+					if(!(request >> command >> hash >> steps >> num_lines_to_print >> time_step) ||
+					   (request >> option && option != "ENERGY")){
+						throw std::invalid_argument("Expected `RUN <hash> <steps> <lines> <time_step> [ENERGY]`.");
+					}
+
+					run(fd, hash, steps, num_lines_to_print, time_step, option == "ENERGY");
+					write_all(fd, "END\n");
+				});
+			}
+			else{
+				submit(pool, done, fd, client, [command]{
+					throw std::invalid_argument("Unknown command `" + command + "`.");
+				});
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Receiving what a client has sent, without waiting.
+	 *
+	 * A disconnected client is closing, and the lines it sent before are still answered.
+	 *
+	 */
+	void receive(int fd, Client& client){
+		char chunk[4096];
+		const ssize_t received{recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT)};
+
+		if(received > 0){
+			client.buffer.append(chunk, received);
+		}
+		else if(received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)){
+			client.closing = true;
+		}
+	}
+}
+
+int main(int argc, char** argv){
+	// socket path and optionally the number of worker threads and the cache directory
+	if(argc < 2 || argc > 4){
+		std::cerr << "ERROR: Expected 1 to 3 arguments, got instead " << argc-1 << ". Program exited." << std::endl;
+		std::exit(1);
+	}
+
+	const std::string path{argv[1]};
+	std::size_t num_threads{std::thread::hardware_concurrency()};
+
+	if(argc >= 3){
+		try{
+			num_threads = std::stoul(argv[2]);
+		}
+		catch(std::invalid_argument& e){
+			std::cerr << "ERROR: Number of threads must be an integer, got instead: " << argv[2]
+					  << ". Program exited.\nReason: " << e.what() << std::endl;
+			std::exit(1);
+		}
+	}
+
+	try{
+		cache = std::make_unique<PlanCache>(argc == 4 ? argv[3] : "");
+	}
+	catch(std::exception& e){
+		std::cerr << "ERROR: Cannot use cache directory `" << argv[3] << "`. Program exited.\nReason: "
+				  << e.what() << std::endl;
+		std::exit(1);
+	}
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if(path.size() >= sizeof(address.sun_path)){
+		std::cerr << "ERROR: Socket path `" << path << "` is too long. Program exited." << std::endl;
+		std::exit(1);
+	}
+	std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+	const int listener{socket(AF_UNIX, SOCK_STREAM, 0)};
+	unlink(path.c_str());
+
+	if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+	   listen(listener, SOMAXCONN) < 0){
+		std::cerr << "ERROR: Cannot listen on `" << path << "`: " << std::strerror(errno) << std::endl;
+		std::exit(1);
+	}
+
+	// a worker writes the socket of a client to `done[1]` when it has answered a request of it
+	int done[2];
+	if(pipe(done) < 0){
+		std::cerr << "ERROR: Cannot create a pipe: " << std::strerror(errno) << std::endl;
+		std::exit(1);
+	}
+
+	ThreadPool pool{num_threads};
+	std::cout << "Listening on " << path << " with " << pool.size() << " threads." << std::endl;
+
+	std::map<int, Client> clients{};
+	std::vector<pollfd> polled{};
+
+	while(true){
+		// clients whose request is being answered are not read from until it is done
+		polled = {{listener, POLLIN, 0}, {done[0], POLLIN, 0}};
+		for(const auto& [fd, client] : clients){
+			if(!client.busy && !client.closing){
+				polled.push_back({fd, POLLIN, 0});
+			}
+		}
+
+		if(poll(polled.data(), polled.size(), -1) < 0){
+			continue;
+		}
+
+		if(polled.at(0).revents != 0){
+			const int client{accept(listener, nullptr, nullptr)};
+			if(client >= 0){
+				clients.emplace(client, Client{});
+			}
+		}
+
+		if(polled.at(1).revents != 0){
+			int answered[64];
+			const ssize_t received{read(done[0], answered, sizeof(answered))};
+			for(ssize_t i{0}; i < received / static_cast<ssize_t>(sizeof(int)); i++){
+				Client& client{clients.at(answered[i])};
+				client.busy = false;
+				if(!dispatch(pool, done[1], answered[i], client)){
+					clients.erase(answered[i]);
+				}
+			}
+		}
+
+		for(std::size_t i{2}; i < polled.size(); i++){
+			if(polled.at(i).revents == 0){
+				continue;
+			}
+
+			const int fd{polled.at(i).fd};
+			Client& client{clients.at(fd)};
+			receive(fd, client);
+			if(!dispatch(pool, done[1], fd, client)){
+				clients.erase(fd);
+			}
+		}
+	}
+
+	return 0;
+}
+
+// ============== END OF FILE ==============
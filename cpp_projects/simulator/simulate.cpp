@@ -16,11 +16,37 @@
  * 	*/
 
 #include <iostream>
-#include "circuit.hpp"
+#include "networks.hpp"
+
+/**
+ * @brief Simulating one circuit network, printing its titles and every `print_step`-th step.
+ *
+ * @param circuit: the circuit network.
+ * @param names: the names of its components.
+ * @param steps: number of simulation steps
+ * @param print_step: number of steps between printed lines.
+ *
+ */
+template<typename C, std::size_t Size>
+void simulate_network(C& circuit, const std::array<std::string_view, Size>& names, int steps, int print_step){
+	circuit.print_titles(names);
+
+	for(int step = 0; step < steps; step++){
+		circuit.step();
+
+		if((step+1) % print_step == 0){
+			circuit.step_print();
+			std::cout << std::endl;
+		}
+	}
+}
 
 /**
  * @brief Simulating three different circuit networks.
  * 
+ * The networks are fixed, so they are simulated as StaticCircuit types (see networks.hpp),
+ * which print the same as the equivalent Circuit.
+ * 
  * @param steps: number of simulation steps
  * @param num_lines_to_print: number of lines to print to the console out of the total number of steps.
  * @param time_step: the step size used for time, in seconds. 
@@ -28,82 +54,25 @@
  * 
  */
 void simulate(int steps, int num_lines_to_print, float time_step, double voltage){
-	Component::time_step = time_step;
 	int print_step{steps / num_lines_to_print};
 	
 	{
-		Circuit circuit{};
-		
-		Connection P, N, R23, R124;
-	
-		circuit.add_component(new Battery("Bat", voltage, P, N));
-		circuit.add_component(new Resistor("R1", 6, P, R124));
-		circuit.add_component(new Resistor("R2", 4, R124, R23));
-		circuit.add_component(new Resistor("R3", 8, R23, N));
-		circuit.add_component(new Resistor("R4", 12, R124, N));
-	
-		circuit.print_titles();
-
-		for(int step = 0; step < steps; step++){
-			circuit.step();
-
-			if((step+1) % print_step == 0){
-				circuit.step_print();
-				std::cout << std::endl;
-			}
-		}
+		FourResistorsNetwork circuit{four_resistors_network(time_step, voltage)};
+		simulate_network(circuit, four_resistors_names, steps, print_step);
 	}
 
 	std::cout << std::endl;
 
 	{
-		Circuit circuit{};
-		
-		Connection P, N, L, R;
-
-		circuit.add_component(new Battery("Bat", voltage, P, N));
-		circuit.add_component(new Resistor("R1", 150, P, L));
-		circuit.add_component(new Resistor("R2", 50, P, R));
-		circuit.add_component(new Resistor("R3", 100, L, R));
-		circuit.add_component(new Resistor("R4", 300, L, N));
-		circuit.add_component(new Resistor("R5", 250, R, N));
-	
-		circuit.print_titles();
-
-		for(int step = 0; step < steps; step++){
-			circuit.step();
-
-			if((step+1) % print_step == 0){
-				circuit.step_print();
-				std::cout << std::endl;
-			}
-		}
+		FiveResistorsNetwork circuit{five_resistors_network(time_step, voltage)};
+		simulate_network(circuit, five_resistors_names, steps, print_step);
 	}
 
 	std::cout << std::endl;
 
 	{
-		Circuit circuit{};
-		
-		Connection P, N, L, R;
-
-		circuit.add_component(new Battery("Bat", voltage, P, N));
-		circuit.add_component(new Resistor("R1", 150, P, L));
-		circuit.add_component(new Resistor("R2", 50, P, R));
-		circuit.add_component(new Capacitor("C3", 1.0, L, R));
-		circuit.add_component(new Resistor("R4", 300, L, N));
-		circuit.add_component(new Capacitor("C5", 0.75, R, N));
-	
-		circuit.print_titles();
-
-		for(int step = 0; step < steps; step++){
-			circuit.step();
-
-			if((step+1) % print_step == 0){
-				circuit.step_print();
-				std::cout << std::endl;
-			}
-		}
+		CapacitorsNetwork circuit{capacitors_network(time_step, voltage)};
+		simulate_network(circuit, capacitors_names, steps, print_step);
 	}
 }
 
@@ -0,0 +1,249 @@
+/**
+ * static_circuit.hpp
+ * ------------------
+ * Description:
+ * 	Header-only, compile-time counterpart of the Circuit framework.
+ *
+ * 	A StaticCircuit is described entirely by its template arguments: the number
+ * 	of connection points and the list of components, where every component carries
+ * 	the indices of its two terminals as template parameters. The charges of the
+ * 	connection points are kept in a `std::array`, and stepping the circuit expands
+ * 	into a fold over the components, so there is no virtual dispatch and no reference
+ * 	chasing, and the compiler is free to fully unroll and inline the step function.
+ *
+ * 	The components follow exactly the same rules as Battery, Resistor and Capacitor
+ * 	in circuit.cpp, and stepping a StaticCircuit gives the same results as stepping
+ * 	the equivalent Circuit. The charges are checked like in Connection, and the
+ * 	circuit is printed like Circuit, given the names of its components.
+ *
+ * Example:
+ * 	StaticCircuit<4, StaticBattery<0, 1>, StaticResistor<0, 2>, StaticResistor<2, 1>>
+ * 		circuit{0.01f, {24.0}, {6}, {4}};
+ * 	circuit.step();
+ * 	circuit.get_voltage<1>();
+ * 	circuit.step_print();
+ *
+ * */
+
+#ifndef STATIC_CIRCUIT_HPP
+#define STATIC_CIRCUIT_HPP
+
+#include <array>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+
+namespace helper {
+	/**
+	 * @brief Moving charge from the most positive terminal to the least positive one.
+	 *
+	 * Same rule and checks as Component::_update_connections_charges().
+	 *
+	 * @throws std::invalid_argument if the charge is negative, or larger than the
+	 *  charge of the terminal it is taken from.
+	 *
+	 */
+	template<std::size_t A, std::size_t B, std::size_t N>
+	constexpr void move_charge(std::array<double, N>& charges, double c){
+		if(c < 0){
+			throw std::invalid_argument("Charge cannot be negative.");
+		}
+		if(c > (charges[A] > charges[B] ? charges[A] : charges[B])){
+			throw std::invalid_argument("Charge too high. Will result in invalid charge.");
+		}
+
+		if(charges[A] > charges[B]){
+			charges[A] -= c;
+			charges[B] += c;
+		}
+		else{
+			charges[A] += c;
+			charges[B] -= c;
+		}
+	}
+
+	// the voltage over two terminals is the difference between their charges.
+	template<std::size_t A, std::size_t B, std::size_t N>
+	constexpr double voltage_between(const std::array<double, N>& charges){
+		if(charges[A] > charges[B]){
+			return charges[A] - charges[B];
+		}
+		return charges[B] - charges[A];
+	}
+}
+
+/**
+ * @brief Battery connected to the connection points with indices A and B.
+ *
+ * Each step the battery sets the charge of A to its voltage and the charge of B to zero.
+ *
+ */
+template<std::size_t A, std::size_t B>
+struct StaticBattery{
+	static constexpr std::size_t terminal_a{A};
+	static constexpr std::size_t terminal_b{B};
+
+	double voltage;
+	double current{0};
+
+	template<std::size_t N>
+	constexpr void step(std::array<double, N>& charges, double){
+		charges[A] = voltage;
+		charges[B] = 0.0;
+	}
+};
+
+/**
+ * @brief Resistor connected to the connection points with indices A and B.
+ *
+ * Each step the resistor moves a charge proportional to the voltage over it.
+ *
+ */
+template<std::size_t A, std::size_t B>
+struct StaticResistor{
+	static constexpr std::size_t terminal_a{A};
+	static constexpr std::size_t terminal_b{B};
+
+	double resistance;
+	double voltage{0};
+	double current{0};
+
+	template<std::size_t N>
+	constexpr void step(std::array<double, N>& charges, double time_step){
+		double charge_to_move{(voltage / resistance) * time_step};
+		helper::move_charge<A, B>(charges, charge_to_move);
+		voltage = helper::voltage_between<A, B>(charges);
+		current = voltage / resistance;
+	}
+};
+
+/**
+ * @brief Capacitor connected to the connection points with indices A and B.
+ *
+ * Each step the capacitor moves some charge forward and stores some of it as well.
+ *
+ */
+template<std::size_t A, std::size_t B>
+struct StaticCapacitor{
+	static constexpr std::size_t terminal_a{A};
+	static constexpr std::size_t terminal_b{B};
+
+	double capacitance;
+	double voltage{0};
+	double current{0};
+	double charge_stored{0};
+
+	template<std::size_t N>
+	constexpr void step(std::array<double, N>& charges, double time_step){
+		double charge_to_store{capacitance * (voltage - charge_stored) * time_step};
+		helper::move_charge<A, B>(charges, charge_to_store);
+		charge_stored += charge_to_store;
+		voltage = helper::voltage_between<A, B>(charges);
+		current = capacitance * (voltage - charge_stored);
+	}
+};
+
+/**
+ * @brief Circuit network with a topology fixed at compile time.
+ *
+ * @tparam N: number of connection points.
+ * @tparam Parts: the components, stepped in the order given.
+ *
+ */
+template<std::size_t N, typename... Parts>
+class StaticCircuit{
+	static_assert(((Parts::terminal_a < N && Parts::terminal_b < N) && ...),
+				  "Terminal index out of range.");
+
+public:
+	/**
+	 * @brief Initializing a circuit where all connection points have zero charge.
+	 *
+	 * @param time_step: the step size used for time, in seconds.
+	 * @param parts: the components, in the same order as the template arguments.
+	 *
+	 */
+	constexpr StaticCircuit(float time_step, Parts... parts)
+		: _time_step{time_step}, _charges{}, _parts{parts...}
+		{}
+
+	static constexpr std::size_t size(){
+		return sizeof...(Parts);
+	}
+
+	/**
+	 * @brief Stepping the circuit network.
+	 *
+	 * All components are stepped once, in order.
+	 *
+	 */
+	constexpr void step(){
+		std::apply([this](Parts&... parts){
+			(parts.step(_charges, _time_step), ...);
+		}, _parts);
+	}
+
+	template<std::size_t I>
+	constexpr double get_voltage() const{
+		return std::get<I>(_parts).voltage;
+	}
+
+	template<std::size_t I>
+	constexpr double get_current() const{
+		return std::get<I>(_parts).current;
+	}
+
+	template<std::size_t Node>
+	constexpr double get_charge() const{
+		return std::get<Node>(_charges);
+	}
+
+	/**
+	 * @brief Printing the names of the components, followed by a voltage and a current title for each.
+	 *
+	 * The same titles as Circuit::print_titles prints.
+	 *
+	 * @param names: the names of the components, in order.
+	 * @param os: an output stream, by default std::cout is used.
+	 *
+	 */
+	void print_titles(const std::array<std::string_view, sizeof...(Parts)>& names,
+					  std::ostream& os = std::cout) const{
+		for(const std::string_view name : names){
+			os << std::setw(12) << name;
+		}
+		os << std::endl;
+
+		for(std::size_t i{0}; i < size(); i++){
+			os << std::setw(6) << "Volt" << std::setw(6) << "Curr";
+		}
+		os << std::endl;
+	}
+
+	/**
+	 * @brief Printing all component's voltage and current at the moment.
+	 *
+	 * The same line as Circuit::step_print prints.
+	 *
+	 * @param os: an output stream, by default std::cout is used.
+	 *
+	 */
+	void step_print(std::ostream& os = std::cout) const{
+		os << std::fixed << std::setprecision(2);
+		std::apply([&os](const Parts&... parts){
+			((os << std::setw(6) << parts.voltage << std::setw(6) << parts.current), ...);
+		}, _parts);
+	}
+
+private:
+	double _time_step;
+	std::array<double, N> _charges;
+	std::tuple<Parts...> _parts;
+};
+
+#endif // STATIC_CIRCUIT_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,86 @@
+/**
+ * thread_pool.cpp
+ * ---------------
+ * Description:
+ *
+ * 	----- Thread Pool -----
+ *
+ * 	A fixed number of worker threads that run submitted jobs in the order they
+ * 	were submitted. The threads are started once and reused, so that running a
+ * 	job does not pay for creating a thread.
+ *
+ * 	*/
+
+#include <algorithm>
+#include "thread_pool.hpp"
+
+/**
+ * @brief Initializing a pool and starting its workers.
+ *
+ * @param num_threads: number of worker threads, at least one is started.
+ *
+ */
+ThreadPool::ThreadPool(std::size_t num_threads)
+	: _mutex{}, _condition{}, _jobs{}, _stopping{false}, _workers{}
+{
+	for(std::size_t i{0}; i < std::max<std::size_t>(num_threads, 1); i++){
+		_workers.emplace_back(&ThreadPool::_work, this);
+	}
+}
+
+/**
+ * @brief Destructing a pool.
+ *
+ * Jobs that are already submitted are finished before the workers are joined.
+ *
+ */
+ThreadPool::~ThreadPool(){
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+		_stopping = true;
+	}
+	_condition.notify_all();
+
+	for(std::thread& worker : _workers){
+		worker.join();
+	}
+}
+
+/**
+ * @brief Submitting a job to be run by one of the workers.
+ *
+ * @param job: the function to run.
+ *
+ */
+void ThreadPool::submit(std::function<void()> job){
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+		_jobs.push(std::move(job));
+	}
+	_condition.notify_one();
+}
+
+std::size_t ThreadPool::size() const{
+	return _workers.size();
+}
+
+// each worker waits for jobs and runs them, until the pool is stopping and no jobs are left.
+void ThreadPool::_work(){
+	while(true){
+		std::function<void()> job{};
+		{
+			std::unique_lock<std::mutex> lock{_mutex};
+			_condition.wait(lock, [this]{ return _stopping || !_jobs.empty(); });
+
+			if(_jobs.empty()){
+				return;
+			}
+
+			job = std::move(_jobs.front());
+			_jobs.pop();
+		}
+		job();
+	}
+}
+
+// ============== END OF FILE ==============
@@ -0,0 +1,44 @@
+/**
+ * thread_pool.hpp
+ * ---------------
+ * Description:
+ * 	Header file containing declarations for a fixed-size pool of worker threads.
+ * */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool{
+public:
+	explicit ThreadPool(std::size_t num_threads);
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool();
+
+	void submit(std::function<void()> job);
+
+	std::size_t size() const;
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::queue<std::function<void()>> _jobs;
+	bool _stopping;
+	std::vector<std::thread> _workers;
+
+	void _work();
+};
+
+#endif // THREAD_POOL_HPP
+
+// ============== END OF FILE ==============
@@ -0,0 +1,28 @@
+#include "thread_pool.hpp"
+#include "../../test/catch.hpp"
+#include <atomic>
+
+// -------------- UNIT TESTS --------------
+
+// --- Class ThreadPool ---
+TEST_CASE("ThreadPool: Test submit"){
+	std::atomic<int> counter{0};
+
+	{
+		ThreadPool pool{4};
+		REQUIRE(pool.size() == 4);
+
+		for(int i{0}; i < 1000; i++){
+			pool.submit([&counter]{ counter++; });
+		}
+	}
+
+	// all submitted jobs are finished before the pool is destructed
+	REQUIRE(counter == 1000);
+
+	// at least one worker is always started
+	ThreadPool single{0};
+	REQUIRE(single.size() == 1);
+}
+
+// ============== END OF FILE ==============